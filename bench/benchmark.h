@@ -0,0 +1,110 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+#include "json_escape.h"
+#include "perf_counters.h"
+#include "trace_recorder.h"
+
+// Minimal benchmark harness which reports results as JSON
+// Each benchmark is a function which performs the given count of operations and returns a checksum,
+// the checksum is consumed so the compiler can't drop the measured work
+class BenchmarkSuite {
+public:
+    // Result of one benchmark
+    struct Result {
+        std::string name;
+        std::uint64_t iterations = 0;
+        double ns_per_op = 0.0;
+        double ops_per_s = 0.0;
+        // Additional named values written to JSON as they are, e.g. peak RSS of end-to-end runs
+        std::vector<std::pair<std::string, double>> metrics;
+    };
+
+    static constexpr double DEFAULT_MIN_TIME = 0.2;
+
+    // Constructors
+    explicit BenchmarkSuite(std::string suite_name_arg, double min_time_arg = DEFAULT_MIN_TIME);
+
+    // Parse common command line options: --json <file>, --min-time <seconds>, --filter <substring>, --perf-counters on|off,
+    // --trace <file> to record Chrome trace-event timeline of benchmarks
+    // If hardware counters are requested but unavailable, benchmarks run without them
+    // Returns false if command line is invalid
+    bool parseCommandLine(int argc, char** argv);
+
+    // Check if benchmark with given name is selected by --filter
+    bool isSelected(const std::string& name) const;
+
+    // Check if hardware counters were requested and could be opened
+    bool isPerfCountersEnabled() const noexcept;
+
+    // Recorder of benchmark timeline, it records nothing unless --trace is given
+    TraceRecorder* getTraceRecorder() noexcept;
+
+    // Add ratios and per-operation values of available hardware counters to result metrics
+    // Metric names are prefixed with prefix, e.g. "verify_" gives "verify_ipc"
+    static void addHardwareMetrics(Result& result, const std::string& prefix, const HardwareCounters& counters, double operation_count);
+
+    // Check if benchmark with given name is selected by non-empty --filter
+    // Expensive benchmarks are run only when they are requested explicitly
+    bool isExplicitlySelected(const std::string& name) const;
+
+    // Run benchmark, iteration count is doubled until the run takes at least min_time
+    // If steps_per_op is given, interpreter throughput is reported as steps_per_s metric
+    template<typename Function>
+    void run(const std::string& name, Function&& function, double steps_per_op = 0.0);
+
+    // Add result measured outside of run()
+    void addResult(const Result& result);
+
+    // Access to results
+    const std::vector<Result>& getResults() const noexcept;
+
+    // Format results as JSON
+    std::string toJson() const;
+
+    // Print results to standard output and write JSON to file given by --json, if any
+    // Returns false if JSON file can't be written
+    bool report() const;
+
+private:
+    std::string suite_name;
+    double min_time;
+    std::string json_file_name;
+    std::string filter;
+    std::vector<Result> results;
+    PerfCounters perf_counters;
+    TraceRecorder trace;
+    volatile std::uint64_t checksum_sink = 0;
+};
+
+// Discards everything written to the stream while it is alive, e.g. progress output of Optimize::speed()
+class ScopedSilence {
+public:
+    explicit ScopedSilence(std::ostream& stream_arg = std::cout);
+    ~ScopedSilence();
+
+    ScopedSilence(const ScopedSilence&) = delete;
+    ScopedSilence& operator=(const ScopedSilence&) = delete;
+
+private:
+    class NullBuffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type symbol) override;
+        std::streamsize xsputn(const char_type* text, std::streamsize count) override;
+    };
+
+    std::ostream& stream;
+    NullBuffer null_buffer;
+    std::streambuf* saved_buffer;
+};
+
+// Peak resident set size of the current process in bytes, 0 if it isn't available
+std::uint64_t getPeakRssBytes();
@@ -0,0 +1,249 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include "json_escape.hpp"
+#include "perf_counters.hpp"
+#include "trace_recorder.hpp"
+#include "benchmark.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+// Constructors
+inline BenchmarkSuite::BenchmarkSuite(std::string suite_name_arg, double min_time_arg)
+    : suite_name(std::move(suite_name_arg)), min_time(min_time_arg) {
+}
+
+// Parse common command line options
+inline bool BenchmarkSuite::parseCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for option " << option << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--json") {
+            json_file_name = value;
+        } else if (option == "--min-time") {
+            min_time = std::atof(value.c_str());
+        } else if (option == "--filter") {
+            filter = value;
+        } else if (option == "--trace") {
+            if (!trace.openStream(value)) {
+                std::cerr << "Can't write " << value << std::endl;
+                return false;
+            }
+        } else if (option == "--perf-counters") {
+            if (value != "on" && value != "off") {
+                std::cerr << "Invalid value " << value << " for option " << option << ", expected on or off" << std::endl;
+                return false;
+            }
+            perf_counters.close();
+            std::string error;
+            if (value == "on" && !perf_counters.open(error)) {
+                std::cerr << "Hardware counters unavailable: " << error << std::endl;
+            }
+        } else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check if benchmark with given name is selected by --filter
+inline bool BenchmarkSuite::isSelected(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+// Check if hardware counters were requested and could be opened
+inline bool BenchmarkSuite::isPerfCountersEnabled() const noexcept {
+    return perf_counters.isOpen();
+}
+
+// Recorder of benchmark timeline
+inline TraceRecorder* BenchmarkSuite::getTraceRecorder() noexcept {
+    return &trace;
+}
+
+// Add ratios and per-operation values of available hardware counters to result metrics
+inline void BenchmarkSuite::addHardwareMetrics(Result& result, const std::string& prefix, const HardwareCounters& counters, double operation_count) {
+    if (counters.isAvailable(EHardwareCounter::Cycles) && counters.isAvailable(EHardwareCounter::Instructions)) {
+        result.metrics.emplace_back(prefix + "ipc", counters.getIpc());
+    }
+    if (counters.isAvailable(EHardwareCounter::Branches) && counters.isAvailable(EHardwareCounter::BranchMisses)) {
+        result.metrics.emplace_back(prefix + "branch_miss_rate", counters.getBranchMissRate());
+    }
+    if (counters.isAvailable(EHardwareCounter::CacheReferences) && counters.isAvailable(EHardwareCounter::CacheMisses)) {
+        result.metrics.emplace_back(prefix + "cache_miss_rate", counters.getCacheMissRate());
+    }
+    if (operation_count <= 0.0) {
+        return;
+    }
+    for (std::size_t i = 0; i < HardwareCounters::COUNTER_COUNT; ++i) {
+        if (counters.available[i]) {
+            result.metrics.emplace_back(prefix + getHardwareCounterName(static_cast<EHardwareCounter>(i)) + "_per_op",
+                                        static_cast<double>(counters.values[i]) / operation_count);
+        }
+    }
+}
+
+// Check if benchmark with given name is selected by non-empty --filter
+inline bool BenchmarkSuite::isExplicitlySelected(const std::string& name) const {
+    return !filter.empty() && name.find(filter) != std::string::npos;
+}
+
+// Run benchmark
+template<typename Function>
+inline void BenchmarkSuite::run(const std::string& name, Function&& function, double steps_per_op) {
+    if (!isSelected(name)) {
+        return;
+    }
+
+    TraceSpan span(&trace, "benchmark", name.c_str());
+
+    // Warm up caches and branch predictors
+    checksum_sink = checksum_sink + function(1);
+
+    std::uint64_t iterations = 1;
+    while (true) {
+        const HardwareCounters hardware_start = perf_counters.read();
+        const auto start = std::chrono::steady_clock::now();
+        checksum_sink = checksum_sink + function(iterations);
+        const auto finish = std::chrono::steady_clock::now();
+        const HardwareCounters hardware_finish = perf_counters.read();
+
+        const double seconds = std::chrono::duration<double>(finish - start).count();
+        if (seconds >= min_time || iterations >= (std::uint64_t(1) << 40)) {
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.ns_per_op = seconds * 1e9 / static_cast<double>(iterations);
+            result.ops_per_s = seconds > 0.0 ? static_cast<double>(iterations) / seconds : 0.0;
+            if (steps_per_op > 0.0) {
+                result.metrics.emplace_back("steps_per_s", result.ops_per_s * steps_per_op);
+            }
+            addHardwareMetrics(result, "", hardware_finish - hardware_start, static_cast<double>(iterations));
+            addResult(result);
+            return;
+        }
+        iterations *= 2;
+    }
+}
+
+// Add result measured outside of run()
+inline void BenchmarkSuite::addResult(const Result& result) {
+    results.push_back(result);
+}
+
+// Access to results
+inline const std::vector<BenchmarkSuite::Result>& BenchmarkSuite::getResults() const noexcept {
+    return results;
+}
+
+// Format results as JSON
+inline std::string BenchmarkSuite::toJson() const {
+    std::ostringstream oss;
+    oss << std::setprecision(10);
+    oss << "{\n";
+    oss << "  \"suite\": \"" << escapeJson(suite_name) << "\",\n";
+#ifdef ALGOPT_BUILD_TYPE
+    oss << "  \"build_type\": \"" << escapeJson(ALGOPT_BUILD_TYPE) << "\",\n";
+#endif
+    oss << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        oss << (i == 0 ? "\n" : ",\n");
+        oss << "    {\"name\": \"" << escapeJson(result.name) << "\""
+            << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": " << result.ns_per_op
+            << ", \"ops_per_s\": " << result.ops_per_s;
+        for (const auto& metric : result.metrics) {
+            oss << ", \"" << escapeJson(metric.first) << "\": " << metric.second;
+        }
+        oss << "}";
+    }
+    oss << "\n  ]\n";
+    oss << "}\n";
+    return oss.str();
+}
+
+// Print results and write JSON file
+inline bool BenchmarkSuite::report() const {
+    for (const Result& result : results) {
+        std::cout << std::left << std::setw(48) << result.name << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(2) << result.ns_per_op << " ns/op"
+                  << std::setw(16) << std::setprecision(0) << result.ops_per_s << " ops/s";
+        std::cout << std::defaultfloat << std::setprecision(6);
+        for (const auto& metric : result.metrics) {
+            std::cout << "  " << metric.first << "=" << metric.second;
+        }
+        std::cout << std::endl;
+    }
+    if (json_file_name.empty()) {
+        return true;
+    }
+    std::ofstream file(json_file_name, std::ios::out | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Can't write " << json_file_name << std::endl;
+        return false;
+    }
+    file << toJson();
+    return static_cast<bool>(file);
+}
+
+// Scoped silence of output stream
+inline ScopedSilence::ScopedSilence(std::ostream& stream_arg)
+    : stream(stream_arg), saved_buffer(stream_arg.rdbuf(&null_buffer)) {
+}
+
+inline ScopedSilence::~ScopedSilence() {
+    stream.rdbuf(saved_buffer);
+}
+
+inline ScopedSilence::NullBuffer::int_type ScopedSilence::NullBuffer::overflow(int_type symbol) {
+    return traits_type::not_eof(symbol);
+}
+
+inline std::streamsize ScopedSilence::NullBuffer::xsputn(const char_type*, std::streamsize count) {
+    return count;
+}
+
+// Peak resident set size of the current process
+inline std::uint64_t getPeakRssBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss); // Bytes on macOS
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // Kilobytes on Linux
+#endif
+#endif
+}
@@ -0,0 +1,55 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal JSON document model, enough to read benchmark results back
+class JsonValue {
+public:
+    enum class EType {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    // Constructors
+    JsonValue() = default;
+
+    // Parse JSON text, returns false and fills error if text is not valid JSON
+    bool parse(const std::string& text, std::string& error);
+
+    // Access to type and value
+    EType getType() const noexcept;
+    bool getBool() const noexcept;
+    double getNumber() const noexcept;
+    const std::string& getString() const noexcept;
+
+    // Access to array elements
+    const std::vector<JsonValue>& getElements() const noexcept;
+
+    // Access to object members in the order they were written
+    const std::vector<std::pair<std::string, JsonValue>>& getMembers() const noexcept;
+
+    // Find object member by key, returns nullptr if there is no such member
+    const JsonValue* find(const std::string& key) const;
+
+private:
+    EType type = EType::Null;
+    bool bool_value = false;
+    double number_value = 0.0;
+    std::string string_value;
+    std::vector<JsonValue> elements;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    bool parseValue(const std::string& text, std::size_t& position, std::string& error);
+    static bool parseString(const std::string& text, std::size_t& position, std::string& result, std::string& error);
+    static void skipSpaces(const std::string& text, std::size_t& position);
+};
@@ -0,0 +1,208 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cctype>
+#include <cstdlib>
+#include "json_value.h"
+
+// Parse JSON text
+inline bool JsonValue::parse(const std::string& text, std::string& error) {
+    std::size_t position = 0;
+    if (!parseValue(text, position, error)) {
+        return false;
+    }
+    skipSpaces(text, position);
+    if (position != text.size()) {
+        error = "Unexpected text after JSON value at offset " + std::to_string(position);
+        return false;
+    }
+    return true;
+}
+
+// Access to type and value
+inline JsonValue::EType JsonValue::getType() const noexcept {
+    return type;
+}
+
+inline bool JsonValue::getBool() const noexcept {
+    return bool_value;
+}
+
+inline double JsonValue::getNumber() const noexcept {
+    return number_value;
+}
+
+inline const std::string& JsonValue::getString() const noexcept {
+    return string_value;
+}
+
+// Access to array elements
+inline const std::vector<JsonValue>& JsonValue::getElements() const noexcept {
+    return elements;
+}
+
+// Access to object members
+inline const std::vector<std::pair<std::string, JsonValue>>& JsonValue::getMembers() const noexcept {
+    return members;
+}
+
+// Find object member by key
+inline const JsonValue* JsonValue::find(const std::string& key) const {
+    for (const auto& member : members) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+inline bool JsonValue::parseValue(const std::string& text, std::size_t& position, std::string& error) {
+    *this = JsonValue();
+    skipSpaces(text, position);
+    if (position >= text.size()) {
+        error = "Unexpected end of JSON";
+        return false;
+    }
+
+    const char symbol = text[position];
+    if (symbol == '{') {
+        type = EType::Object;
+        ++position;
+        skipSpaces(text, position);
+        if (position < text.size() && text[position] == '}') {
+            ++position;
+            return true;
+        }
+        while (true) {
+            skipSpaces(text, position);
+            std::string key;
+            if (!parseString(text, position, key, error)) {
+                return false;
+            }
+            skipSpaces(text, position);
+            if (position >= text.size() || text[position] != ':') {
+                error = "Expected ':' at offset " + std::to_string(position);
+                return false;
+            }
+            ++position;
+            JsonValue value;
+            if (!value.parseValue(text, position, error)) {
+                return false;
+            }
+            members.emplace_back(std::move(key), std::move(value));
+            skipSpaces(text, position);
+            if (position < text.size() && text[position] == ',') {
+                ++position;
+            } else if (position < text.size() && text[position] == '}') {
+                ++position;
+                return true;
+            } else {
+                error = "Expected ',' or '}' at offset " + std::to_string(position);
+                return false;
+            }
+        }
+    }
+    if (symbol == '[') {
+        type = EType::Array;
+        ++position;
+        skipSpaces(text, position);
+        if (position < text.size() && text[position] == ']') {
+            ++position;
+            return true;
+        }
+        while (true) {
+            JsonValue value;
+            if (!value.parseValue(text, position, error)) {
+                return false;
+            }
+            elements.push_back(std::move(value));
+            skipSpaces(text, position);
+            if (position < text.size() && text[position] == ',') {
+                ++position;
+            } else if (position < text.size() && text[position] == ']') {
+                ++position;
+                return true;
+            } else {
+                error = "Expected ',' or ']' at offset " + std::to_string(position);
+                return false;
+            }
+        }
+    }
+    if (symbol == '"') {
+        type = EType::String;
+        return parseString(text, position, string_value, error);
+    }
+    if (text.compare(position, 4, "true") == 0) {
+        type = EType::Bool;
+        bool_value = true;
+        position += 4;
+        return true;
+    }
+    if (text.compare(position, 5, "false") == 0) {
+        type = EType::Bool;
+        position += 5;
+        return true;
+    }
+    if (text.compare(position, 4, "null") == 0) {
+        position += 4;
+        return true;
+    }
+
+    // Number
+    const char* begin = text.c_str() + position;
+    char* end = nullptr;
+    number_value = std::strtod(begin, &end);
+    if (end == begin) {
+        error = "Unexpected symbol at offset " + std::to_string(position);
+        return false;
+    }
+    type = EType::Number;
+    position += static_cast<std::size_t>(end - begin);
+    return true;
+}
+
+inline bool JsonValue::parseString(const std::string& text, std::size_t& position, std::string& result, std::string& error) {
+    if (position >= text.size() || text[position] != '"') {
+        error = "Expected string at offset " + std::to_string(position);
+        return false;
+    }
+    ++position;
+    result.clear();
+    while (position < text.size()) {
+        const char symbol = text[position++];
+        if (symbol == '"') {
+            return true;
+        }
+        if (symbol != '\\') {
+            result += symbol;
+            continue;
+        }
+        if (position >= text.size()) {
+            break;
+        }
+        const char escaped = text[position++];
+        switch (escaped) {
+            case 'n': result += '\n'; break;
+            case 't': result += '\t'; break;
+            case 'r': result += '\r'; break;
+            case 'b': result += '\b'; break;
+            case 'f': result += '\f'; break;
+            case 'u':
+                // Benchmark names are ASCII, other code points are replaced
+                position += 4;
+                result += '?';
+                break;
+            default: result += escaped; break;
+        }
+    }
+    error = "Unterminated string";
+    return false;
+}
+
+inline void JsonValue::skipSpaces(const std::string& text, std::size_t& position) {
+    while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) {
+        ++position;
+    }
+}
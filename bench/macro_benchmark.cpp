@@ -0,0 +1,265 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "B0/instructions.h"
+#include "B1/instructions.h"
+#include "S0/instructions.h"
+#include "B0/instructions.hpp"
+#include "B1/instructions.hpp"
+#include "S0/instructions.hpp"
+#include "address.hpp"
+#include "fabric.h"
+#include "fabric.hpp"
+#include "inline_program.h"
+#include "inline_program.hpp"
+#include "optimize.h"
+#include "optimize.hpp"
+#include "program.hpp"
+#include "variables.h"
+#include "variables.hpp"
+#include "benchmark.h"
+#include "benchmark.hpp"
+
+namespace {
+
+// Optimum of problem whose size limit is too small to hold any better program than the reference
+constexpr std::uint64_t UNKNOWN_OPTIMUM = std::numeric_limits<std::uint64_t>::max();
+
+template<unsigned N, unsigned K, unsigned T>
+Address<N, K, T> input(unsigned index) {
+    return {Address<N, K, T>::EAddressType::Input, index};
+}
+
+template<unsigned N, unsigned K, unsigned T>
+Address<N, K, T> output(unsigned index) {
+    return {Address<N, K, T>::EAddressType::Output, index};
+}
+
+template<unsigned N, unsigned K, unsigned T>
+Address<N, K, T> temp(unsigned index) {
+    return {Address<N, K, T>::EAddressType::Temp, index};
+}
+
+// Count of candidates enumerated by Optimize::speed() for program sizes 1..max_program_size
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+std::uint64_t getCandidateCount(unsigned max_program_size) {
+    std::uint64_t total = 0;
+    for (unsigned program_size = 1; program_size <= max_program_size; ++program_size) {
+        const std::uint64_t combination_count = InstructionSet<N, K, T>::getCombinationCount(program_size);
+        std::uint64_t count = 1;
+        for (unsigned i = 0; i < program_size; ++i) {
+            count *= combination_count;
+        }
+        total += count;
+    }
+    return total;
+}
+
+// Run end-to-end search for one problem of the corpus
+// expected_total_steps is the known optimum reachable within max_program_size, it is below the cost of the reference
+// Problems with UNKNOWN_OPTIMUM measure search throughput only, they report neither optimum nor whether it was found
+// expected_wall_time_s is wall time of the search on the machine which recorded bench/baseline/macro.json
+// Search runs on ProgramClass, e.g. on InlineProgram, reference is copied into it
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T,
+         typename ProgramClass = Program<InstructionSet, N, K, T>>
+void runProblem(BenchmarkSuite& suite, const std::string& name, const Program<InstructionSet, N, K, T>& reference,
+                unsigned max_program_size, std::uint64_t expected_total_steps, double expected_wall_time_s, bool heavy = false) {
+    if (heavy ? !suite.isExplicitlySelected(name) : !suite.isSelected(name)) {
+        return;
+    }
+
+    using OptimizeType = Optimize<InstructionSet, N, K, T, ProgramClass>;
+    ProgramClass original(reference.size());
+    for (const auto& instruction : reference) {
+        original.add(instruction);
+    }
+    OptimizeType optimize(original);
+    typename OptimizeType::ResultSinkType sink(OptimizeType::ResultSinkType::EMode::CountOnly);
+    optimize.setHardwareCountersEnabled(suite.isPerfCountersEnabled());
+    optimize.setTraceRecorder(suite.getTraceRecorder());
+    TraceSpan span(suite.getTraceRecorder(), "benchmark", name.c_str());
+
+    const auto start = std::chrono::steady_clock::now();
+    typename OptimizeType::ProgramType best;
+    {
+        ScopedSilence silence;
+        best = optimize.speed(max_program_size, sink);
+    }
+    const auto finish = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(finish - start).count();
+    const std::uint64_t candidate_count = getCandidateCount<InstructionSet, N, K, T>(max_program_size);
+    const std::uint64_t best_total_steps = optimize.calculateAverageSteps(best);
+
+    BenchmarkSuite::Result result;
+    result.name = name;
+    result.iterations = candidate_count;
+    result.ns_per_op = seconds * 1e9 / static_cast<double>(candidate_count);
+    result.ops_per_s = seconds > 0.0 ? static_cast<double>(candidate_count) / seconds : 0.0;
+    result.metrics = {
+        {"wall_time_s", seconds},
+        {"expected_wall_time_s", expected_wall_time_s},
+        {"candidates", static_cast<double>(candidate_count)},
+        {"candidates_per_s", result.ops_per_s},
+        {"valid_candidates", static_cast<double>(sink.getCount())},
+        {"peak_rss_bytes", static_cast<double>(getPeakRssBytes())},
+        {"best_total_steps", static_cast<double>(best_total_steps)}
+    };
+    if (expected_total_steps != UNKNOWN_OPTIMUM) {
+        result.metrics.push_back({"expected_total_steps", static_cast<double>(expected_total_steps)});
+        result.metrics.push_back({"optimum_found", best_total_steps == expected_total_steps ? 1.0 : 0.0});
+    }
+
+    // Hardware counters of each search phase, per candidate
+    const SearchStats stats = optimize.getStats();
+    for (std::size_t i = 0; i < SearchCounters::SEARCH_PHASE_COUNT; ++i) {
+        const ESearchPhase phase = static_cast<ESearchPhase>(i);
+        BenchmarkSuite::addHardwareMetrics(result, std::string(getSearchPhaseName(phase)) + "_", stats.total.getHardware(phase),
+                                           static_cast<double>(candidate_count));
+    }
+    suite.addResult(result);
+}
+
+// output[0] = input[0] + input[1] by two counting loops
+void runSum(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2, K = 1, T = 0;
+    Program<B1::InstructionSet, N, K, T> program;
+    program.add(B1::JumpIfZero<N, K, T>{input<N, K, T>(0), 4});
+    program.add(B1::Inc<N, K, T>{output<N, K, T>(0)});
+    program.add(B1::Dec<N, K, T>{input<N, K, T>(0)});
+    program.add(B1::Goto<N, K, T>{0});
+    program.add(B1::JumpIfZero<N, K, T>{input<N, K, T>(1), 8});
+    program.add(B1::Dec<N, K, T>{input<N, K, T>(1)});
+    program.add(B1::Inc<N, K, T>{output<N, K, T>(0)});
+    program.add(B1::Goto<N, K, T>{4});
+
+    // Optimum is "Add o0 = i0 + i1", one instruction takes 0 RabbitTurtle steps
+    runProblem(suite, "speed/sum/B1", program, 1, 0, 0.05);
+}
+
+// output[0] = max(input[0], input[1])
+void runMax(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2, K = 1, T = 0;
+    Program<B0::InstructionSet, N, K, T> program;
+    program.add(B0::JumpIfGreater<N, K, T>{input<N, K, T>(0), input<N, K, T>(1), 3});
+    program.add(B0::Move<N, K, T>{input<N, K, T>(1), output<N, K, T>(0)});
+    program.add(B0::Goto<N, K, T>{4});
+    program.add(B0::Move<N, K, T>{input<N, K, T>(0), output<N, K, T>(0)});
+
+    // Optimum jumps over the second assignment also on equal inputs, e.g.
+    // "JumpIfGreaterOrEqual i0 >= i1 -> 2; Add i0 = i1 + o0; Add o0 = i0 + o0"
+    runProblem(suite, "speed/max/B0", program, 3, 32640, 41.0);
+}
+
+// output[0] = min(input[0], input[1])
+void runMin(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2, K = 1, T = 0;
+    Program<B0::InstructionSet, N, K, T> program;
+    program.add(B0::JumpIfLess<N, K, T>{input<N, K, T>(0), input<N, K, T>(1), 3});
+    program.add(B0::Move<N, K, T>{input<N, K, T>(1), output<N, K, T>(0)});
+    program.add(B0::Goto<N, K, T>{4});
+    program.add(B0::Move<N, K, T>{input<N, K, T>(0), output<N, K, T>(0)});
+
+    // Optimum jumps over the second assignment also on equal inputs
+    runProblem(suite, "speed/min/B0", program, 3, 32640, 126.0);
+}
+
+// output[0] = |input[0] - input[1]|
+void runAbsoluteDifference(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2, K = 1, T = 0;
+    Program<B0::InstructionSet, N, K, T> program;
+    program.add(B0::JumpIfGreater<N, K, T>{input<N, K, T>(0), input<N, K, T>(1), 3});
+    program.add(B0::Sub<N, K, T>{input<N, K, T>(1), input<N, K, T>(0), output<N, K, T>(0)});
+    program.add(B0::Goto<N, K, T>{4});
+    program.add(B0::Sub<N, K, T>{input<N, K, T>(0), input<N, K, T>(1), output<N, K, T>(0)});
+
+    // Optimum jumps over the second subtraction also on equal inputs, e.g.
+    // "Sub o0 = i0 - i1; JumpIfGreaterOrEqual i0 >= i1 -> 3; Sub o0 = i1 - i0"
+    runProblem(suite, "speed/absolute_difference/B0", program, 3, 32640, 30.0);
+
+    // Same search on programs which store instructions inline, so candidates never allocate
+    runProblem<B0::InstructionSet, N, K, T, InlineProgram<B0::InstructionSet, N, K, T, 4>>(
+        suite, "speed_inline/absolute_difference/B0", program, 3, 32640, 30.0);
+}
+
+// output[0] = input[0] != 0 ? input[1] : 0
+// Select among three inputs needs three instructions, search of size 3 over 2^24 inputs takes days, so the other value is 0
+void runConditionalSelect(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2, K = 1, T = 0;
+    Program<B1::InstructionSet, N, K, T> program;
+    program.add(B1::JumpIfZero<N, K, T>{input<N, K, T>(0), 3});
+    program.add(B1::Move<N, K, T>{input<N, K, T>(1), output<N, K, T>(0)});
+    program.add(B1::Goto<N, K, T>{3});
+
+    // Optimum drops the jump to the end: "JumpIfZero i0 == 0 -> 2; Move o0 = i1"
+    runProblem(suite, "speed/conditional_select/B1", program, 2, 0, 1.0);
+}
+
+// Compare-exchange of output[temp[index1]] and output[temp[index2]]: smaller value goes first
+template<unsigned N, unsigned K, unsigned T>
+void addCompareExchange(Program<S0::InstructionSet, N, K, T>& program, unsigned index1, unsigned index2) {
+    using AddressType = Address<N, K, T>;
+    const std::size_t position = program.size();
+    program.add(S0::JumpIfLessIndirect<N, K, T>{temp<N, K, T>(index1), temp<N, K, T>(index2), AddressType::EAddressType::Output, position + 2});
+    program.add(S0::SwapIndirect<N, K, T>{temp<N, K, T>(index1), temp<N, K, T>(index2), AddressType::EAddressType::Output});
+}
+
+// Sorting network copying inputs to outputs, temp[i] holds index i + 1, the last temp is 0
+template<unsigned N, std::size_t PairCount>
+Program<S0::InstructionSet, N, N, N> makeSortingNetwork(const unsigned (&pairs)[PairCount][2]) {
+    constexpr unsigned K = N, T = N;
+    Program<S0::InstructionSet, N, K, T> program;
+    for (unsigned i = 0; i < N; ++i) {
+        program.add(S0::Move<N, K, T>{input<N, K, T>(i), output<N, K, T>(i)});
+    }
+    for (unsigned i = 0; i + 1 < N; ++i) {
+        program.add(S0::SetC<N, K, T>{temp<N, K, T>(i), static_cast<std::uint8_t>(i + 1)});
+    }
+    for (std::size_t i = 0; i < PairCount; ++i) {
+        // Index 0 lives in the last temp
+        const unsigned index1 = pairs[i][0] == 0 ? N - 1 : pairs[i][0] - 1;
+        const unsigned index2 = pairs[i][1] == 0 ? N - 1 : pairs[i][1] - 1;
+        addCompareExchange(program, index1, index2);
+    }
+    return program;
+}
+
+// Sorting of 3 values in S0
+void runSort3(BenchmarkSuite& suite) {
+    static const unsigned pairs[][2] = {{0, 1}, {1, 2}, {0, 1}};
+
+    // No sorting program fits into any size which can be searched, so only throughput is measured
+    runProblem(suite, "speed/sort3/S0", makeSortingNetwork<3>(pairs), 1, UNKNOWN_OPTIMUM, 3.4);
+}
+
+// Sorting of 4 values in S0
+// Reference runs on all 2^32 inputs, the whole run takes over half an hour, so it runs only with --filter sort4
+void runSort4(BenchmarkSuite& suite) {
+    static const unsigned pairs[][2] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+
+    // No sorting program fits into any size which can be searched, so only throughput is measured
+    runProblem(suite, "speed/sort4/S0", makeSortingNetwork<4>(pairs), 1, UNKNOWN_OPTIMUM, 1280.0, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkSuite suite("macro");
+    if (!suite.parseCommandLine(argc, argv)) {
+        return 1;
+    }
+
+    runSum(suite);
+    runMax(suite);
+    runMin(suite);
+    runAbsoluteDifference(suite);
+    runConditionalSelect(suite);
+    runSort3(suite);
+    runSort4(suite);
+
+    return suite.report() ? 0 : 1;
+}
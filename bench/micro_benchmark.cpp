@@ -0,0 +1,283 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "B0/instructions.h"
+#include "B1/instructions.h"
+#include "S0/instructions.h"
+#include "B0/instructions.hpp"
+#include "B1/instructions.hpp"
+#include "S0/instructions.hpp"
+#include "address.hpp"
+#include "executor.h"
+#include "executor.hpp"
+#include "fabric.h"
+#include "fabric.hpp"
+#include "full_state.hpp"
+#include "optimize.h"
+#include "optimize.hpp"
+#include "program.hpp"
+#include "rabbit_turtle.h"
+#include "rabbit_turtle.hpp"
+#include "variables.h"
+#include "variables.hpp"
+#include "benchmark.h"
+#include "benchmark.hpp"
+
+namespace {
+
+// Program length used to enumerate instructions, jump targets must fit into it
+constexpr unsigned INSTRUCTION_PROGRAM_LEN = 4;
+
+// Instruction name from its dump, e.g. "0: Add o0 = i0 + i1" gives "Add"
+template<typename InstructionSetType>
+std::string getInstructionName(const InstructionSetType& instruction) {
+    const std::string text = instruction.dump(0);
+    const std::size_t start = text.find(": ") + 2;
+    const std::size_t finish = text.find(' ', start);
+    return text.substr(start, finish == std::string::npos ? std::string::npos : finish - start);
+}
+
+// First instruction of each type in combination order
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+std::vector<InstructionSet<N, K, T>> collectInstructionTypes() {
+    using InstructionSetType = InstructionSet<N, K, T>;
+    std::vector<InstructionSetType> instructions;
+    const std::uint64_t count = InstructionSetType::getCombinationCount(INSTRUCTION_PROGRAM_LEN);
+    for (std::uint64_t index = 0; index < count; ++index) {
+        const InstructionSetType instruction = InstructionSetType::getCombination(index, INSTRUCTION_PROGRAM_LEN);
+        bool found = false;
+        for (const InstructionSetType& existing : instructions) {
+            if (existing.type == instruction.type) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            instructions.push_back(instruction);
+        }
+    }
+    return instructions;
+}
+
+template<unsigned N>
+InputVariables<N> makeInput(std::uint8_t first_value) {
+    InputVariables<N> input;
+    for (unsigned i = 0; i < N; ++i) {
+        input.values[i] = static_cast<std::uint8_t>(first_value + i);
+    }
+    return input;
+}
+
+// Cost of executing one instruction of each type
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+void benchmarkInstructions(BenchmarkSuite& suite, const std::string& set_name) {
+    using InstructionSetType = InstructionSet<N, K, T>;
+    using FullStateType = FullState<N, K, T>;
+
+    for (InstructionSetType instruction : collectInstructionTypes<InstructionSet, N, K, T>()) {
+        const FullStateType initial_state(Variables<N, K, T>(makeInput<N>(1)), 0);
+        suite.run("execute/" + set_name + "/" + getInstructionName(instruction), [&](std::uint64_t iterations) {
+            FullStateType state = initial_state;
+            std::uint64_t checksum = 0;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                instruction.execute(state);
+                checksum += state.instructionPointer();
+                state.instructionPointer() = 0;
+            }
+            return checksum + state.getVariables().output.values[0];
+        }, 1.0);
+    }
+}
+
+// Cost of Program::execute dispatch over a straight-line program of all non-jump instruction types
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+void benchmarkProgramDispatch(BenchmarkSuite& suite, const std::string& set_name) {
+    using FullStateType = FullState<N, K, T>;
+
+    Program<InstructionSet, N, K, T> program;
+    for (const auto& instruction : collectInstructionTypes<InstructionSet, N, K, T>()) {
+        const std::string name = getInstructionName(instruction);
+        if (name.rfind("Jump", 0) != 0 && name.rfind("Goto", 0) != 0) {
+            program.add(instruction);
+        }
+    }
+
+    const FullStateType initial_state(Variables<N, K, T>(makeInput<N>(1)), 0);
+    suite.run("program_execute/" + set_name, [&](std::uint64_t iterations) {
+        FullStateType state = initial_state;
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            if (!program.execute(state)) {
+                checksum += state.getVariables().output.values[0];
+                state.instructionPointer() = 0;
+            }
+        }
+        return checksum;
+    }, 1.0);
+}
+
+// Overhead of RabbitTurtle compared with plain Executor on the B1 sum loop program
+void benchmarkExecutors(BenchmarkSuite& suite) {
+    constexpr unsigned N = 2;
+    constexpr unsigned K = 1;
+    constexpr unsigned T = 0;
+    using AddressType = Address<N, K, T>;
+    using ProgramType = Program<B1::InstructionSet, N, K, T>;
+
+    // output[0] = input[0] + input[1] by counting loops
+    ProgramType program;
+    B1::JumpIfZero<N, K, T> jump_if_zero0;
+    jump_if_zero0.operand = {AddressType::EAddressType::Input, 0};
+    jump_if_zero0.target = 4;
+    program.add(jump_if_zero0);
+    B1::Inc<N, K, T> inc_output;
+    inc_output.address = {AddressType::EAddressType::Output, 0};
+    program.add(inc_output);
+    B1::Dec<N, K, T> dec_input0;
+    dec_input0.address = {AddressType::EAddressType::Input, 0};
+    program.add(dec_input0);
+    B1::Goto<N, K, T> goto0;
+    goto0.target = 0;
+    program.add(goto0);
+    B1::JumpIfZero<N, K, T> jump_if_zero1;
+    jump_if_zero1.operand = {AddressType::EAddressType::Input, 1};
+    jump_if_zero1.target = 8;
+    program.add(jump_if_zero1);
+    B1::Dec<N, K, T> dec_input1;
+    dec_input1.address = {AddressType::EAddressType::Input, 1};
+    program.add(dec_input1);
+    program.add(inc_output);
+    B1::Goto<N, K, T> goto1;
+    goto1.target = 4;
+    program.add(goto1);
+
+    const InputVariables<N> input = makeInput<N>(7);
+
+    // Count of instructions executed by one run
+    Executor<B1::InstructionSet, N, K, T> executor(program, input);
+    double steps_per_run = 1.0;
+    while (executor.execute()) {
+        ++steps_per_run;
+    }
+
+    suite.run("run/executor", [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            executor.reset(input);
+            while (executor.execute()) {
+            }
+            checksum += executor.getFullState().getVariables().output.values[0];
+        }
+        return checksum;
+    }, steps_per_run);
+
+    RabbitTurtle<B1::InstructionSet, N, K, T> rabbit_turtle(program, input);
+    suite.run("run/rabbit_turtle", [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            rabbit_turtle.reset(input);
+            while (rabbit_turtle.execute() && !rabbit_turtle.isInfiniteLoopDetected()) {
+            }
+            checksum += rabbit_turtle.getOutput().values[0];
+        }
+        return checksum;
+    }, steps_per_run);
+
+    suite.run("run/rabbit_turtle_construct", [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            RabbitTurtle<B1::InstructionSet, N, K, T> local_rabbit_turtle(program, input);
+            while (local_rabbit_turtle.execute() && !local_rabbit_turtle.isInfiniteLoopDetected()) {
+            }
+            checksum += local_rabbit_turtle.getOutput().values[0];
+        }
+        return checksum;
+    }, steps_per_run);
+}
+
+// Throughput of candidate enumeration
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+void benchmarkFabric(BenchmarkSuite& suite, const std::string& set_name, unsigned program_len) {
+    Fabric<InstructionSet, N, K, T> fabric(program_len);
+    suite.run("fabric_next/" + set_name, [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            checksum += fabric.next() ? 1 : 0;
+        }
+        return checksum + fabric.getRank();
+    });
+
+    suite.run("fabric_generate/" + set_name, [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            checksum += fabric.generate().size();
+            fabric.next();
+        }
+        return checksum;
+    });
+}
+
+// Cost of full verification of one candidate against the original program over all inputs
+void benchmarkProducesSameOutput(BenchmarkSuite& suite) {
+    constexpr unsigned N = 1;
+    constexpr unsigned K = 1;
+    constexpr unsigned T = 0;
+    constexpr unsigned PROGRAM_LEN = 2;
+    using AddressType = Address<N, K, T>;
+    using ProgramType = Program<B1::InstructionSet, N, K, T>;
+
+    // output[0] = input[0]
+    ProgramType original;
+    B1::Move<N, K, T> move;
+    move.source = {AddressType::EAddressType::Input, 0};
+    move.destination = {AddressType::EAddressType::Output, 0};
+    original.add(move);
+
+    std::vector<ProgramType> candidates;
+    Fabric<B1::InstructionSet, N, K, T> fabric(PROGRAM_LEN);
+    do {
+        candidates.push_back(fabric.generate());
+    } while (fabric.next());
+
+    const Optimize<B1::InstructionSet, N, K, T> optimize(original);
+    suite.run("produces_same_output/B1", [&](std::uint64_t iterations) {
+        std::uint64_t checksum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            std::uint64_t total_steps = 0;
+            if (optimize.producesSameOutput(candidates[i % candidates.size()], total_steps)) {
+                checksum += total_steps;
+            }
+        }
+        return checksum;
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkSuite suite("micro");
+    if (!suite.parseCommandLine(argc, argv)) {
+        return 1;
+    }
+
+    benchmarkInstructions<B0::InstructionSet, 2, 1, 1>(suite, "B0");
+    benchmarkInstructions<B1::InstructionSet, 2, 1, 1>(suite, "B1");
+    benchmarkInstructions<S0::InstructionSet, 2, 1, 1>(suite, "S0");
+
+    benchmarkProgramDispatch<B0::InstructionSet, 2, 1, 1>(suite, "B0");
+    benchmarkProgramDispatch<B1::InstructionSet, 2, 1, 1>(suite, "B1");
+    benchmarkProgramDispatch<S0::InstructionSet, 2, 1, 1>(suite, "S0");
+
+    benchmarkExecutors(suite);
+
+    benchmarkFabric<B0::InstructionSet, 2, 1, 0>(suite, "B0", 3);
+    benchmarkFabric<B1::InstructionSet, 2, 1, 0>(suite, "B1", 3);
+    benchmarkFabric<S0::InstructionSet, 2, 1, 0>(suite, "S0", 3);
+
+    benchmarkProducesSameOutput(suite);
+
+    return suite.report() ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "benchmark.hpp"
+#include "json_value.h"
+#include "json_value.hpp"
+
+// Performance regression gate
+// Usage:
+//   algopt_bench_gate --baseline <file> [options] -- <benchmark command>
+//   algopt_bench_gate --baseline <file> [options] --current <file> [--current <file> ...]
+// Options:
+//   --repeat <count>         Run benchmark command count times, default 5
+//   --threshold <fraction>   Minimal relative slowdown of the median which is reported, default 0.1
+//   --alpha <probability>    Significance level of one-sided Mann-Whitney U test, default 0.01
+//   --metric <name>          Gated metric, higher is better, can be repeated
+//                            Default: ops_per_s, candidates_per_s, steps_per_s
+//   --write-baseline <file>  Write samples of current runs as new baseline instead of comparing
+// Exit code is 0 if there are no regressions, 1 on regression, 2 on invalid usage or input
+// Slowdown is a regression only if it exceeds threshold and the test finds it significant,
+// so 5 runs against 5 baseline runs are needed to reach the default significance level
+// If there are too few samples to reach it, slowdown is only reported as a warning with the count of runs needed
+// Baselines in bench/baseline are written by:
+//   algopt_bench_gate --write-baseline bench/baseline/micro.json -- algopt_bench --min-time 0.05
+//   algopt_bench_gate --write-baseline bench/baseline/macro.json -- algopt_macro_bench
+// and are checked with the same benchmark command and --baseline instead of --write-baseline
+
+namespace {
+
+// Samples of each metric of each benchmark: samples[benchmark][metric]
+using SampleMap = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+constexpr int EXIT_REGRESSION = 1;
+constexpr int EXIT_ERROR = 2;
+
+// Both samples sizes up to this limit use exact distribution of U statistic
+constexpr std::size_t EXACT_TEST_LIMIT = 40;
+
+struct Options {
+    std::string baseline_file_name;
+    std::string write_baseline_file_name;
+    std::vector<std::string> current_file_names;
+    std::vector<std::string> metrics;
+    std::string command;
+    unsigned repeat = 5;
+    double threshold = 0.1;
+    double alpha = 0.01;
+};
+
+bool parseCommandLine(int argc, char** argv, Options& options) {
+    int i = 1;
+    for (; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option == "--") {
+            ++i;
+            break;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for option " << option << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--baseline") {
+            options.baseline_file_name = value;
+        } else if (option == "--write-baseline") {
+            options.write_baseline_file_name = value;
+        } else if (option == "--current") {
+            options.current_file_names.push_back(value);
+        } else if (option == "--metric") {
+            options.metrics.push_back(value);
+        } else if (option == "--repeat") {
+            options.repeat = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (option == "--threshold") {
+            options.threshold = std::atof(value.c_str());
+        } else if (option == "--alpha") {
+            options.alpha = std::atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return false;
+        }
+    }
+    for (; i < argc; ++i) {
+        if (!options.command.empty()) {
+            options.command += ' ';
+        }
+        options.command += argv[i];
+    }
+
+    if (options.metrics.empty()) {
+        options.metrics = {"ops_per_s", "candidates_per_s", "steps_per_s"};
+    }
+    if (options.command.empty() == options.current_file_names.empty()) {
+        std::cerr << "Either benchmark command or --current files must be given" << std::endl;
+        return false;
+    }
+    if (options.baseline_file_name.empty() == options.write_baseline_file_name.empty()) {
+        std::cerr << "Either --baseline or --write-baseline must be given" << std::endl;
+        return false;
+    }
+    if (options.repeat == 0) {
+        std::cerr << "Repeat count must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Load benchmark JSON, single values and arrays of values are both accepted as samples
+bool loadSamples(const std::string& file_name, SampleMap& samples, std::string& suite_name) {
+    std::ifstream file(file_name);
+    if (!file) {
+        std::cerr << "Can't read " << file_name << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    JsonValue document;
+    std::string error;
+    if (!document.parse(buffer.str(), error)) {
+        std::cerr << file_name << ": " << error << std::endl;
+        return false;
+    }
+    const JsonValue* suite = document.find("suite");
+    if (suite && suite->getType() == JsonValue::EType::String) {
+        suite_name = suite->getString();
+    }
+    const JsonValue* benchmarks = document.find("benchmarks");
+    if (!benchmarks || benchmarks->getType() != JsonValue::EType::Array) {
+        std::cerr << file_name << ": no benchmarks array" << std::endl;
+        return false;
+    }
+
+    for (const JsonValue& benchmark : benchmarks->getElements()) {
+        const JsonValue* name = benchmark.find("name");
+        if (!name || name->getType() != JsonValue::EType::String) {
+            continue;
+        }
+        auto& metrics = samples[name->getString()];
+        for (const auto& member : benchmark.getMembers()) {
+            if (member.second.getType() == JsonValue::EType::Number) {
+                metrics[member.first].push_back(member.second.getNumber());
+            } else if (member.second.getType() == JsonValue::EType::Array) {
+                for (const JsonValue& element : member.second.getElements()) {
+                    if (element.getType() == JsonValue::EType::Number) {
+                        metrics[member.first].push_back(element.getNumber());
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Write samples as baseline JSON, each metric is an array of samples
+bool writeBaseline(const std::string& file_name, const std::string& suite_name, const SampleMap& samples) {
+    std::ofstream file(file_name, std::ios::out | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Can't write " << file_name << std::endl;
+        return false;
+    }
+    file << std::setprecision(10);
+    file << "{\n";
+    file << "  \"suite\": \"" << escapeJson(suite_name) << "\",\n";
+    file << "  \"benchmarks\": [";
+    bool first_benchmark = true;
+    for (const auto& benchmark : samples) {
+        file << (first_benchmark ? "\n" : ",\n");
+        first_benchmark = false;
+        file << "    {\"name\": \"" << escapeJson(benchmark.first) << "\"";
+        for (const auto& metric : benchmark.second) {
+            file << ", \"" << escapeJson(metric.first) << "\": [";
+            for (std::size_t i = 0; i < metric.second.size(); ++i) {
+                file << (i == 0 ? "" : ", ") << metric.second[i];
+            }
+            file << "]";
+        }
+        file << "}";
+    }
+    file << "\n  ]\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+// Run benchmark command repeat times and collect samples
+bool runCommand(const Options& options, SampleMap& samples, std::string& suite_name) {
+    const std::filesystem::path json_path =
+        std::filesystem::temp_directory_path() / ("algopt_bench_gate_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".json");
+    for (unsigned run = 0; run < options.repeat; ++run) {
+        std::cout << "Run " << run + 1 << " of " << options.repeat << ": " << options.command << std::endl;
+        const std::string command = options.command + " --json \"" + json_path.string() + "\"";
+        if (std::system(command.c_str()) != 0) {
+            std::cerr << "Benchmark command failed" << std::endl;
+            return false;
+        }
+        const bool loaded = loadSamples(json_path.string(), samples, suite_name);
+        std::error_code error;
+        std::filesystem::remove(json_path, error);
+        if (!loaded) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double getMedian(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const std::size_t middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+// Probability that U statistic of samples of sizes n1 and n2 is not greater than u
+// Exact distribution is counted for small samples, ties are ignored there
+double getMannWhitneyProbability(std::size_t n1, std::size_t n2, double u) {
+    if (n1 + n2 <= EXACT_TEST_LIMIT) {
+        // table[i][j][v]: count of arrangements of i and j samples with U == v
+        // The largest sample either belongs to the first group and adds j to U, or to the second group and adds nothing
+        std::vector<std::vector<std::vector<double>>> table(n1 + 1, std::vector<std::vector<double>>(n2 + 1));
+        for (std::size_t i = 0; i <= n1; ++i) {
+            for (std::size_t j = 0; j <= n2; ++j) {
+                table[i][j].assign(i * j + 1, 0.0);
+                if (i == 0 || j == 0) {
+                    table[i][j][0] = 1.0;
+                    continue;
+                }
+                for (std::size_t v = 0; v <= i * j; ++v) {
+                    double value = 0.0;
+                    if (v >= j && v - j <= (i - 1) * j) {
+                        value += table[i - 1][j][v - j];
+                    }
+                    if (v <= i * (j - 1)) {
+                        value += table[i][j - 1][v];
+                    }
+                    table[i][j][v] = value;
+                }
+            }
+        }
+
+        const std::vector<double>& distribution = table[n1][n2];
+        double total = 0.0;
+        double below = 0.0;
+        for (std::size_t v = 0; v < distribution.size(); ++v) {
+            total += distribution[v];
+            if (static_cast<double>(v) <= u + 1e-9) {
+                below += distribution[v];
+            }
+        }
+        return below / total;
+    }
+
+    // Normal approximation with continuity correction
+    const double mean = static_cast<double>(n1 * n2) / 2.0;
+    const double deviation = std::sqrt(static_cast<double>(n1 * n2 * (n1 + n2 + 1)) / 12.0);
+    const double z = (u + 0.5 - mean) / deviation;
+    return 0.5 * std::erfc(-z / std::sqrt(2.0));
+}
+
+// One-sided Mann-Whitney U test, alternative hypothesis: current values are lower than baseline values
+double getRegressionProbability(const std::vector<double>& current, const std::vector<double>& baseline) {
+    // U counts pairs where current sample is above baseline sample, ties count as a half
+    double u = 0.0;
+    for (const double current_value : current) {
+        for (const double baseline_value : baseline) {
+            if (current_value > baseline_value) {
+                u += 1.0;
+            } else if (current_value == baseline_value) {
+                u += 0.5;
+            }
+        }
+    }
+    return getMannWhitneyProbability(current.size(), baseline.size(), u);
+}
+
+// Smallest p-value which the test can produce for given sample sizes
+double getMinimalProbability(std::size_t n1, std::size_t n2) {
+    double combinations = 1.0;
+    for (std::size_t i = 1; i <= n1; ++i) {
+        combinations = combinations * static_cast<double>(n2 + i) / static_cast<double>(i);
+    }
+    return 1.0 / combinations;
+}
+
+// Smallest count of current samples which lets the test reach alpha against n2 baseline samples, 0 if none does
+std::size_t getRequiredSampleCount(std::size_t n2, double alpha) {
+    constexpr std::size_t MAX_SAMPLE_COUNT = 1000;
+    for (std::size_t n1 = 1; n1 <= MAX_SAMPLE_COUNT; ++n1) {
+        if (getMinimalProbability(n1, n2) <= alpha) {
+            return n1;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseCommandLine(argc, argv, options)) {
+        return EXIT_ERROR;
+    }
+
+    SampleMap current;
+    std::string suite_name;
+    if (!options.command.empty()) {
+        if (!runCommand(options, current, suite_name)) {
+            return EXIT_ERROR;
+        }
+    } else {
+        for (const std::string& file_name : options.current_file_names) {
+            if (!loadSamples(file_name, current, suite_name)) {
+                return EXIT_ERROR;
+            }
+        }
+    }
+
+    if (!options.write_baseline_file_name.empty()) {
+        if (!writeBaseline(options.write_baseline_file_name, suite_name, current)) {
+            return EXIT_ERROR;
+        }
+        std::cout << "Baseline written to " << options.write_baseline_file_name << std::endl;
+        return 0;
+    }
+
+    SampleMap baseline;
+    std::string baseline_suite_name;
+    if (!loadSamples(options.baseline_file_name, baseline, baseline_suite_name)) {
+        return EXIT_ERROR;
+    }
+
+    unsigned regression_count = 0;
+    unsigned untestable_count = 0;
+    std::size_t required_sample_count = 0; // 0 if some baseline is too small for any count of current runs
+    std::cout << std::left << std::setw(44) << "benchmark" << std::setw(18) << "metric" << std::right
+              << std::setw(14) << "baseline" << std::setw(14) << "current" << std::setw(10) << "change"
+              << std::setw(10) << "p" << "  verdict" << std::endl;
+    for (const auto& benchmark : baseline) {
+        const auto current_benchmark = current.find(benchmark.first);
+        if (current_benchmark == current.end()) {
+            std::cout << std::left << std::setw(44) << benchmark.first << "missing in current run" << std::endl;
+            continue;
+        }
+        for (const std::string& metric : options.metrics) {
+            const auto baseline_samples = benchmark.second.find(metric);
+            const auto current_samples = current_benchmark->second.find(metric);
+            if (baseline_samples == benchmark.second.end() || current_samples == current_benchmark->second.end() ||
+                baseline_samples->second.empty() || current_samples->second.empty()) {
+                continue;
+            }
+
+            const double baseline_median = getMedian(baseline_samples->second);
+            const double current_median = getMedian(current_samples->second);
+            const double change = baseline_median > 0.0 ? current_median / baseline_median - 1.0 : 0.0;
+            const double probability = getRegressionProbability(current_samples->second, baseline_samples->second);
+
+            // With too few samples the test can't reach significance, then slowdown is only a warning
+            const bool testable = getMinimalProbability(current_samples->second.size(), baseline_samples->second.size()) <= options.alpha;
+            const bool slower = change < -options.threshold;
+            const bool regression = slower && testable && probability <= options.alpha;
+            if (regression) {
+                ++regression_count;
+            }
+            if (slower && !testable) {
+                ++untestable_count;
+                const std::size_t sample_count = getRequiredSampleCount(baseline_samples->second.size(), options.alpha);
+                const bool reachable = untestable_count == 1 || required_sample_count > 0;
+                required_sample_count = reachable && sample_count > 0 ? std::max(required_sample_count, sample_count) : 0;
+            }
+
+            const char* verdict = regression ? "REGRESSION" : (slower ? (testable ? "noise" : "slower?") : "ok");
+            std::cout << std::left << std::setw(44) << benchmark.first << std::setw(18) << metric << std::right
+                      << std::setw(14) << std::setprecision(6) << baseline_median
+                      << std::setw(14) << current_median
+                      << std::setw(9) << std::fixed << std::setprecision(1) << change * 100.0 << "%"
+                      << std::setw(10) << std::setprecision(3) << probability << std::defaultfloat
+                      << "  " << verdict << (testable ? "" : " (too few samples)") << std::endl;
+        }
+    }
+
+    if (untestable_count > 0) {
+        std::cout << "Warning: " << untestable_count << " slowdown(s) can't be tested with alpha " << options.alpha;
+        if (required_sample_count > 0) {
+            std::cout << ", " << required_sample_count << " current runs are needed";
+        } else {
+            std::cout << ", baseline has too few runs";
+        }
+        std::cout << std::endl;
+    }
+    if (regression_count > 0) {
+        std::cout << regression_count << " regression(s) found" << std::endl;
+        return EXIT_REGRESSION;
+    }
+    std::cout << "No regressions found" << std::endl;
+    return 0;
+}
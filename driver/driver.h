@@ -0,0 +1,80 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "packed_instruction.h"
+#include "step_objective.h"
+
+// Ranking of programs by algopt_driver
+enum class EDriverCostModel {
+    Steps, // RabbitTurtle step count
+    Unit,  // Count of executed instructions, see CostModel
+    X86    // Approximate x86 latencies, see CostModel::makeX86()
+};
+
+// Options of algopt_driver, see printDriverUsage()
+struct DriverOptions {
+    static constexpr std::size_t DEFAULT_TOP = 16;
+
+    EInstructionSetId instruction_set = EInstructionSetId::B1;
+    unsigned n = 2;
+    unsigned k = 1;
+    unsigned t = 0;
+    std::string program_file;
+    unsigned max_program_size = 1;
+    std::size_t top = DEFAULT_TOP;
+    double estimate_seconds = 0.0;  // Estimate is skipped if zero
+    bool search = true;
+    EDriverCostModel cost_model = EDriverCostModel::Steps;
+    StepObjective objective;
+    bool perf_counters = false;
+    bool async_io = true;           // Write results and progress by background thread, see AsyncWriter
+    std::string results_file;       // Text of all valid programs
+    std::string store_file;         // Binary result store of all valid programs, see ResultStoreWriter
+    std::string progress_file;      // JSON-lines progress, standard output if empty
+    std::string trace_file;         // Chrome trace-event timeline
+    std::string truth_table_dir;    // Cache of reference truth tables, see Optimize::loadTruthTable()
+};
+
+// Print command line help
+void printDriverUsage();
+
+// Parse command line, returns false and sets error if it is invalid
+bool parseDriverCommandLine(int argc, char** argv, DriverOptions& options, std::string& error);
+
+// Load reference program and optimize it by the instantiation selected by options
+// Returns false and sets error if there is no precompiled instantiation or program can't be loaded
+bool runDriver(const DriverOptions& options, std::string& error);
+
+// Precompiled instantiations of each instruction set, they live in separate translation units to build in parallel
+bool runB0Driver(const DriverOptions& options, std::string& error);
+bool runB1Driver(const DriverOptions& options, std::string& error);
+bool runS0Driver(const DriverOptions& options, std::string& error);
+
+// Count of input, output and temp variables of precompiled instantiation
+template<unsigned N, unsigned K, unsigned T>
+struct DriverShape {
+    static constexpr unsigned INPUT_COUNT = N;
+    static constexpr unsigned OUTPUT_COUNT = K;
+    static constexpr unsigned TEMP_COUNT = T;
+
+    // Check if options select this shape
+    static bool matches(const DriverOptions& options) noexcept;
+
+    // Text representation, e.g. "N=2 K=1 T=0"
+    static std::string toString();
+};
+
+// Selection of precompiled instantiation of instruction set by N, K and T of options
+template<template<unsigned, unsigned, unsigned> class InstructionSet, typename... Shapes>
+struct DriverDispatcher {
+    // Run search with matching shape, returns false and sets error if no shape matches
+    static bool run(const DriverOptions& options, std::string& error);
+};
+
+// Load reference program, print estimate and run search as selected by options
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+bool runDriverSearch(const DriverOptions& options, std::string& error);
@@ -0,0 +1,144 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <iostream>
+#include "assembler.h"
+#include "assembler.hpp"
+#include "async_writer.h"
+#include "async_writer.hpp"
+#include "cost_model.h"
+#include "cost_model.hpp"
+#include "fabric.h"
+#include "fabric.hpp"
+#include "optimize.h"
+#include "optimize.hpp"
+#include "program.hpp"
+#include "result_sink.hpp"
+#include "step_objective.hpp"
+#include "trace_recorder.h"
+#include "trace_recorder.hpp"
+#include "driver.h"
+
+// Check if options select this shape
+template<unsigned N, unsigned K, unsigned T>
+inline bool DriverShape<N, K, T>::matches(const DriverOptions& options) noexcept {
+    return options.n == N && options.k == K && options.t == T;
+}
+
+// Text representation
+template<unsigned N, unsigned K, unsigned T>
+inline std::string DriverShape<N, K, T>::toString() {
+    return "N=" + std::to_string(N) + " K=" + std::to_string(K) + " T=" + std::to_string(T);
+}
+
+// Run search with matching shape
+template<template<unsigned, unsigned, unsigned> class InstructionSet, typename... Shapes>
+inline bool DriverDispatcher<InstructionSet, Shapes...>::run(const DriverOptions& options, std::string& error) {
+    bool result = false;
+    const bool found = ((Shapes::matches(options) &&
+                         (result = runDriverSearch<InstructionSet, Shapes::INPUT_COUNT, Shapes::OUTPUT_COUNT, Shapes::TEMP_COUNT>(options, error), true)) || ...);
+    if (!found) {
+        error = "No precompiled instantiation for N=" + std::to_string(options.n) + " K=" + std::to_string(options.k) +
+                " T=" + std::to_string(options.t) + ", available:";
+        ((error += "\n  " + Shapes::toString()), ...);
+    }
+    return found && result;
+}
+
+// Load reference program, print estimate and run search
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool runDriverSearch(const DriverOptions& options, std::string& error) {
+    using OptimizeType = Optimize<InstructionSet, N, K, T>;
+    using ProgramType = typename OptimizeType::ProgramType;
+
+    ProgramType reference;
+    if (!Assembler<InstructionSet, N, K, T>::loadProgram(options.program_file, reference, error)) {
+        return false;
+    }
+    if (reference.empty()) {
+        error = options.program_file + ": no instructions";
+        return false;
+    }
+
+    // Writer, recorder and cost model must outlive the search
+    AsyncWriter writer;
+    AsyncWriter* const async_writer = options.async_io ? &writer : nullptr;
+    TraceRecorder trace;
+    if (!options.trace_file.empty() && !trace.openStream(options.trace_file)) {
+        error = "Can't write " + options.trace_file;
+        return false;
+    }
+
+    CostModel cost_model;
+    if (options.cost_model == EDriverCostModel::X86) {
+        cost_model = CostModel::makeX86();
+    }
+    OptimizeType optimizer(reference);
+    optimizer.setCostModel(options.cost_model == EDriverCostModel::Steps ? nullptr : &cost_model);
+    optimizer.setObjective(options.objective);
+    const std::string cost_name = optimizer.getCostName();
+    optimizer.setTraceRecorder(&trace);
+    optimizer.setHardwareCountersEnabled(options.perf_counters);
+    if (!options.progress_file.empty() && !optimizer.getProgressReporter().openStream(options.progress_file, async_writer)) {
+        error = "Can't write " + options.progress_file;
+        return false;
+    }
+
+    if (!options.truth_table_dir.empty()) {
+        std::string table_error;
+        if (!optimizer.loadTruthTable(options.truth_table_dir, table_error)) {
+            std::cerr << "Truth table isn't shared: " << table_error << std::endl;
+        }
+    }
+
+    std::cout << "=== Reference Program ===" << std::endl;
+    std::cout << reference.dump();
+    std::cout << "Reference program " << cost_name << ": " << optimizer.calculateObjectiveValue(reference) << std::endl;
+
+    if (options.estimate_seconds > 0.0) {
+        std::cout << "\n=== Search Estimate ===" << std::endl;
+        std::cout << optimizer.estimate(options.max_program_size, options.estimate_seconds).dump() << std::flush;
+    }
+    if (!options.search) {
+        return true;
+    }
+
+    typename OptimizeType::ResultSinkType sink(OptimizeType::ResultSinkType::EMode::TopK, options.top);
+    sink.setCostName(cost_name);
+    if (!options.results_file.empty() && !sink.openStream(options.results_file, async_writer)) {
+        error = "Can't write " + options.results_file;
+        return false;
+    }
+    if (!options.store_file.empty() && !sink.openStore(options.store_file, error, async_writer)) {
+        return false;
+    }
+    const ProgramType best_program = optimizer.speed(options.max_program_size, sink);
+    sink.closeStream();
+    sink.closeStore();
+    optimizer.getProgressReporter().closeStream();
+
+    std::cout << "\n=== Best Valid Programs (" << sink.getKeptCount() << " of " << sink.getCount() << " within cost bound) ===" << std::endl;
+    std::cout << sink.dump();
+    std::cout << "\n=== Search Statistics ===" << std::endl;
+    std::cout << optimizer.getStats().dump();
+    std::cout << "\n=== Optimized Program (" << cost_name << ": " << optimizer.calculateObjectiveValue(best_program) << ") ===" << std::endl;
+    std::cout << best_program.dump() << std::flush;
+
+    // Results are printed anyway, but files which lost some of them make the run fail
+    if (sink.hasWriteError()) {
+        error = "Writing results failed:";
+        for (const std::string& file_name : {options.results_file, options.store_file}) {
+            if (!file_name.empty()) {
+                error += " " + file_name;
+            }
+        }
+        return false;
+    }
+    if (optimizer.getProgressReporter().hasWriteError()) {
+        error = "Writing progress failed: " + options.progress_file;
+        return false;
+    }
+    return true;
+}
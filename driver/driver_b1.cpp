@@ -0,0 +1,19 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include "B1/instructions.h"
+#include "B1/instructions.hpp"
+#include "driver.h"
+#include "driver.hpp"
+
+// Precompiled instantiations of B1
+// Scalar functions of up to 3 inputs with up to 1 temp
+bool runB1Driver(const DriverOptions& options, std::string& error) {
+    return DriverDispatcher<B1::InstructionSet,
+                            DriverShape<1, 1, 0>,
+                            DriverShape<1, 1, 1>,
+                            DriverShape<2, 1, 0>,
+                            DriverShape<2, 1, 1>,
+                            DriverShape<3, 1, 0>,
+                            DriverShape<3, 1, 1>>::run(options, error);
+}
@@ -0,0 +1,154 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "driver.h"
+#include "step_objective.hpp"
+
+// Print command line help
+void printDriverUsage() {
+    std::cout << "Usage: algopt_driver [options] <program file>\n"
+              << "Program file holds reference program in the format of Program::dump(), e.g. \"0: Inc output[0]\"\n"
+              << "Options:\n"
+              << "  --isa B0|B1|S0            instruction set, default B1\n"
+              << "  --n <count>               count of input variables, default 2\n"
+              << "  --k <count>               count of output variables, default 1\n"
+              << "  --t <count>               count of temp variables, default 0\n"
+              << "  --max-size <size>         maximum size of searched programs, default 1\n"
+              << "  --top <count>             count of best programs to print, default " << DriverOptions::DEFAULT_TOP
+              << ", 1 bounds candidates by the current best\n"
+              << "  --estimate <seconds>      estimate the search by sampling before running it\n"
+              << "  --search on|off           run the search, default on\n"
+              << "  --cost-model steps|unit|x86  rank programs by step count, executed instructions or x86 latencies, default steps\n"
+              << "  --objective total|max|p<percentile>  minimise sum, worst input or percentile over inputs, e.g. p99, default total\n"
+              << "  --results <file>          write text of all valid programs to file\n"
+              << "  --store <file>            append all valid programs to binary result store\n"
+              << "  --progress <file>         write JSON-lines progress to file instead of standard output\n"
+              << "  --trace <file>            record Chrome trace-event timeline of the search\n"
+              << "  --perf-counters on|off    measure search phases by hardware counters, default off\n"
+              << "  --async-io on|off         write results and progress by background thread, default on\n"
+              << "  --truth-table-dir <dir>   map reference truth table from directory, it is built and saved there if missing\n";
+}
+
+// Parse command line
+bool parseDriverCommandLine(int argc, char** argv, DriverOptions& options, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        if (option.compare(0, 2, "--") != 0) {
+            if (!options.program_file.empty()) {
+                error = "Unexpected argument " + option;
+                return false;
+            }
+            options.program_file = option;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = "Missing value for option " + option;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (option == "--isa") {
+            if (value == "B0") {
+                options.instruction_set = EInstructionSetId::B0;
+            } else if (value == "B1") {
+                options.instruction_set = EInstructionSetId::B1;
+            } else if (value == "S0") {
+                options.instruction_set = EInstructionSetId::S0;
+            } else {
+                error = "Unknown instruction set " + value + ", expected B0, B1 or S0";
+                return false;
+            }
+        } else if (option == "--n") {
+            options.n = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (option == "--k") {
+            options.k = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (option == "--t") {
+            options.t = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (option == "--max-size") {
+            options.max_program_size = static_cast<unsigned>(std::atoi(value.c_str()));
+        } else if (option == "--top") {
+            options.top = static_cast<std::size_t>(std::atoi(value.c_str()));
+        } else if (option == "--estimate") {
+            options.estimate_seconds = std::atof(value.c_str());
+        } else if (option == "--search" || option == "--perf-counters" || option == "--async-io") {
+            if (value != "on" && value != "off") {
+                error = "Invalid value " + value + " for option " + option + ", expected on or off";
+                return false;
+            }
+            bool& flag = option == "--search" ? options.search : (option == "--perf-counters" ? options.perf_counters : options.async_io);
+            flag = value == "on";
+        } else if (option == "--cost-model") {
+            if (value == "steps") {
+                options.cost_model = EDriverCostModel::Steps;
+            } else if (value == "unit") {
+                options.cost_model = EDriverCostModel::Unit;
+            } else if (value == "x86") {
+                options.cost_model = EDriverCostModel::X86;
+            } else {
+                error = "Unknown cost model " + value + ", expected steps, unit or x86";
+                return false;
+            }
+        } else if (option == "--objective") {
+            const double percentile = value.size() > 1 && value[0] == 'p' ? std::atof(value.c_str() + 1) : 0.0;
+            if (value == "total") {
+                options.objective = StepObjective::makeTotal();
+            } else if (value == "max") {
+                options.objective = StepObjective::makeMax();
+            } else if (percentile > 0.0 && percentile <= 100.0) {
+                options.objective = StepObjective::makePercentile(percentile);
+            } else {
+                error = "Unknown objective " + value + ", expected total, max or p<percentile> with percentile in (0, 100]";
+                return false;
+            }
+        } else if (option == "--results") {
+            options.results_file = value;
+        } else if (option == "--store") {
+            options.store_file = value;
+        } else if (option == "--progress") {
+            options.progress_file = value;
+        } else if (option == "--trace") {
+            options.trace_file = value;
+        } else if (option == "--truth-table-dir") {
+            options.truth_table_dir = value;
+        } else {
+            error = "Unknown option " + option;
+            return false;
+        }
+    }
+    if (options.program_file.empty()) {
+        error = "Missing program file";
+        return false;
+    }
+    return true;
+}
+
+// Load reference program and optimize it
+bool runDriver(const DriverOptions& options, std::string& error) {
+    switch (options.instruction_set) {
+        case EInstructionSetId::B0:
+            return runB0Driver(options, error);
+        case EInstructionSetId::B1:
+            return runB1Driver(options, error);
+        case EInstructionSetId::S0:
+            return runS0Driver(options, error);
+    }
+    error = "Unknown instruction set";
+    return false;
+}
+
+int main(int argc, char** argv) {
+    DriverOptions options;
+    std::string error;
+    if (!parseDriverCommandLine(argc, argv, options, error)) {
+        std::cerr << error << std::endl;
+        printDriverUsage();
+        return 1;
+    }
+    if (!runDriver(options, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,16 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#include "S0/instructions.h"
+#include "S0/instructions.hpp"
+#include "driver.h"
+#include "driver.hpp"
+
+// Precompiled instantiations of S0
+// Sorting problems: inputs are copied to outputs, temps hold indices
+bool runS0Driver(const DriverOptions& options, std::string& error) {
+    return DriverDispatcher<S0::InstructionSet,
+                            DriverShape<2, 2, 2>,
+                            DriverShape<3, 3, 3>,
+                            DriverShape<4, 4, 4>>::run(options, error);
+}
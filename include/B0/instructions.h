@@ -10,6 +10,8 @@
 #include <algorithm>
 #include "address.h"
 #include "full_state.h"
+#include "packed_instruction.h"
+#include "text_format.h"
 
 namespace B0 {
 
@@ -28,6 +30,8 @@ struct Add {
     static Add getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -42,6 +46,8 @@ struct Sub {
     static Sub getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -56,6 +62,8 @@ struct Mul {
     static Mul getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -70,6 +78,8 @@ struct Div {
     static Div getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -83,6 +93,8 @@ struct Move {
     static Move getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -96,6 +108,8 @@ struct Swap {
     static Swap getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -108,6 +122,8 @@ struct Goto {
     static Goto getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -122,6 +138,8 @@ struct JumpIfGreater {
     static JumpIfGreater getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -136,6 +154,8 @@ struct JumpIfLess {
     static JumpIfLess getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -150,6 +170,8 @@ struct JumpIfGreaterOrEqual {
     static JumpIfGreaterOrEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -164,11 +186,16 @@ struct JumpIfLessOrEqual {
     static JumpIfLessOrEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // B0 instruction set as variant type
 template<unsigned N, unsigned K, unsigned T>
 struct InstructionSet {
+    // Identifier of instruction set in serialized programs
+    static constexpr EInstructionSetId ID = EInstructionSetId::B0;
+
     enum class Type : std::uint8_t {
         Add = 0,
         Sub = 1,
@@ -432,25 +459,44 @@ struct InstructionSet {
     
     // Dump instruction
     std::string dump(unsigned line_number) const {
+        char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+        return std::string(buffer, appendTo(buffer, line_number));
+    }
+    
+    // Append dump of instruction without allocation, buffer must fit MAX_INSTRUCTION_TEXT_SIZE characters
+    char* appendTo(char* output, unsigned line_number) const noexcept {
         switch (type) {
-            case Type::Add: return storage.add.dump(line_number);
-            case Type::Sub: return storage.sub.dump(line_number);
-            case Type::Mul: return storage.mul.dump(line_number);
-            case Type::Div: return storage.div.dump(line_number);
-            case Type::Move: return storage.move.dump(line_number);
-            case Type::Swap: return storage.swap.dump(line_number);
-            case Type::Goto: return storage.goto_.dump(line_number);
-            case Type::JumpIfGreater: return storage.jump_if_greater.dump(line_number);
-            case Type::JumpIfLess: return storage.jump_if_less.dump(line_number);
-            case Type::JumpIfGreaterOrEqual: return storage.jump_if_greater_or_equal.dump(line_number);
-            case Type::JumpIfLessOrEqual: return storage.jump_if_less_or_equal.dump(line_number);
+            case Type::Add: return storage.add.appendTo(output, line_number);
+            case Type::Sub: return storage.sub.appendTo(output, line_number);
+            case Type::Mul: return storage.mul.appendTo(output, line_number);
+            case Type::Div: return storage.div.appendTo(output, line_number);
+            case Type::Move: return storage.move.appendTo(output, line_number);
+            case Type::Swap: return storage.swap.appendTo(output, line_number);
+            case Type::Goto: return storage.goto_.appendTo(output, line_number);
+            case Type::JumpIfGreater: return storage.jump_if_greater.appendTo(output, line_number);
+            case Type::JumpIfLess: return storage.jump_if_less.appendTo(output, line_number);
+            case Type::JumpIfGreaterOrEqual: return storage.jump_if_greater_or_equal.appendTo(output, line_number);
+            case Type::JumpIfLessOrEqual: return storage.jump_if_less_or_equal.appendTo(output, line_number);
         }
-        return "";
+        return output;
     }
     
     static std::uint64_t getCombinationCount(unsigned programLen);
     static InstructionSet getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
+    // Encode instruction into packed form
+    PackedInstruction<N, K, T> encode() const;
+    
+    // Check if opcode belongs to this instruction set
+    static bool isSupported(EPackedOpcode opcode) noexcept;
+    
+    // Decode instruction from packed form, opcode must belong to this instruction set
+    static InstructionSet decode(const PackedInstruction<N, K, T>& packed);
+    
+    // Text syntax of instruction produced by dump() after line number, see Assembler for placeholders
+    // Returns null if opcode doesn't belong to this instruction set
+    static const char* getSyntax(EPackedOpcode opcode) noexcept;
+    
 private:
     void destroy() {
         switch (type) {
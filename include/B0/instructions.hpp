@@ -3,10 +3,11 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstdint>
-#include <sstream>
 #include <string>
 #include "address.hpp"
+#include "packed_instruction.hpp"
 
 // Helper functions moved to address.hpp
 
@@ -486,90 +487,360 @@ inline B0::InstructionSet<N, K, T> B0::InstructionSet<N, K, T>::getCombination(s
 // Dump methods for instructions
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Add<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Add " << result.toString() << " = " 
-        << operand1.toString() << " + " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Add<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Add ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " + ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Sub<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Sub " << result.toString() << " = " 
-        << operand1.toString() << " - " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Sub<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Sub ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " - ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Mul<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Mul " << result.toString() << " = " 
-        << operand1.toString() << " * " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Mul<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Mul ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " * ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Div<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Div " << result.toString() << " = " 
-        << operand1.toString() << " / " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Div<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Div ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " / ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Move<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Move " << destination.toString() << " = " 
-        << source.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Move<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Move ");
+    output = destination.appendTo(output);
+    output = appendText(output, " = ");
+    output = source.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Swap<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Swap " << address1.toString() << " <-> " 
-        << address2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Swap<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Swap ");
+    output = address1.appendTo(output);
+    output = appendText(output, " <-> ");
+    output = address2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::Goto<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Goto " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::Goto<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Goto ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::JumpIfGreater<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfGreater " << operand1.toString() << " > " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::JumpIfGreater<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfGreater ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " > ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::JumpIfLess<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfLess " << operand1.toString() << " < " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::JumpIfLess<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfLess ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " < ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::JumpIfGreaterOrEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfGreaterOrEqual " << operand1.toString() << " >= " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::JumpIfGreaterOrEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfGreaterOrEqual ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " >= ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B0::JumpIfLessOrEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfLessOrEqual " << operand1.toString() << " <= " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B0::JumpIfLessOrEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfLessOrEqual ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " <= ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 // Dump method for InstructionSet is already implemented inline in instructions.h
 
+// InstructionSet encode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline PackedInstruction<N, K, T> B0::InstructionSet<N, K, T>::encode() const {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (type) {
+        case Type::Add:
+            return PackedInstructionType::make(EPackedOpcode::Add, PackedInstructionType::packAddress(storage.add.operand1), PackedInstructionType::packAddress(storage.add.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.add.result));
+        case Type::Sub:
+            return PackedInstructionType::make(EPackedOpcode::Sub, PackedInstructionType::packAddress(storage.sub.operand1), PackedInstructionType::packAddress(storage.sub.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.sub.result));
+        case Type::Mul:
+            return PackedInstructionType::make(EPackedOpcode::Mul, PackedInstructionType::packAddress(storage.mul.operand1), PackedInstructionType::packAddress(storage.mul.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.mul.result));
+        case Type::Div:
+            return PackedInstructionType::make(EPackedOpcode::Div, PackedInstructionType::packAddress(storage.div.operand1), PackedInstructionType::packAddress(storage.div.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.div.result));
+        case Type::Move:
+            return PackedInstructionType::make(EPackedOpcode::Move, PackedInstructionType::packAddress(storage.move.source), PackedInstructionType::packAddress(storage.move.destination));
+        case Type::Swap:
+            return PackedInstructionType::make(EPackedOpcode::Swap, PackedInstructionType::packAddress(storage.swap.address1), PackedInstructionType::packAddress(storage.swap.address2));
+        case Type::Goto:
+            return PackedInstructionType::make(EPackedOpcode::Goto, 0, 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.goto_.target));
+        case Type::JumpIfGreater:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfGreater, PackedInstructionType::packAddress(storage.jump_if_greater.operand1), PackedInstructionType::packAddress(storage.jump_if_greater.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_greater.target));
+        case Type::JumpIfLess:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfLess, PackedInstructionType::packAddress(storage.jump_if_less.operand1), PackedInstructionType::packAddress(storage.jump_if_less.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_less.target));
+        case Type::JumpIfGreaterOrEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfGreaterOrEqual, PackedInstructionType::packAddress(storage.jump_if_greater_or_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_greater_or_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_greater_or_equal.target));
+        case Type::JumpIfLessOrEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfLessOrEqual, PackedInstructionType::packAddress(storage.jump_if_less_or_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_less_or_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_less_or_equal.target));
+    }
+    return PackedInstructionType{};
+}
+
+// InstructionSet opcode check implementation
+template<unsigned N, unsigned K, unsigned T>
+inline bool B0::InstructionSet<N, K, T>::isSupported(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::Add:
+        case EPackedOpcode::Sub:
+        case EPackedOpcode::Mul:
+        case EPackedOpcode::Div:
+        case EPackedOpcode::Move:
+        case EPackedOpcode::Swap:
+        case EPackedOpcode::Goto:
+        case EPackedOpcode::JumpIfGreater:
+        case EPackedOpcode::JumpIfLess:
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+        case EPackedOpcode::JumpIfLessOrEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// InstructionSet syntax implementation
+template<unsigned N, unsigned K, unsigned T>
+inline const char* B0::InstructionSet<N, K, T>::getSyntax(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::Add:
+            return "Add {x} = {1} + {2}";
+        case EPackedOpcode::Sub:
+            return "Sub {x} = {1} - {2}";
+        case EPackedOpcode::Mul:
+            return "Mul {x} = {1} * {2}";
+        case EPackedOpcode::Div:
+            return "Div {x} = {1} / {2}";
+        case EPackedOpcode::Move:
+            return "Move {2} = {1}";
+        case EPackedOpcode::Swap:
+            return "Swap {1} <-> {2}";
+        case EPackedOpcode::Goto:
+            return "Goto {n}";
+        case EPackedOpcode::JumpIfGreater:
+            return "JumpIfGreater {1} > {2} -> {n}";
+        case EPackedOpcode::JumpIfLess:
+            return "JumpIfLess {1} < {2} -> {n}";
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+            return "JumpIfGreaterOrEqual {1} >= {2} -> {n}";
+        case EPackedOpcode::JumpIfLessOrEqual:
+            return "JumpIfLessOrEqual {1} <= {2} -> {n}";
+        default:
+            return nullptr;
+    }
+}
+
+// InstructionSet decode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline B0::InstructionSet<N, K, T> B0::InstructionSet<N, K, T>::decode(const PackedInstruction<N, K, T>& packed) {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (packed.getOpcode()) {
+        case EPackedOpcode::Add: {
+            Add<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Sub: {
+            Sub<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Mul: {
+            Mul<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Div: {
+            Div<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Move: {
+            Move<N, K, T> instruction;
+            instruction.source = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.destination = PackedInstructionType::unpackAddress(packed.getOperand2());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Swap: {
+            Swap<N, K, T> instruction;
+            instruction.address1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.address2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Goto: {
+            Goto<N, K, T> instruction;
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfGreater: {
+            JumpIfGreater<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfLess: {
+            JumpIfLess<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfGreaterOrEqual: {
+            JumpIfGreaterOrEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfLessOrEqual: {
+            JumpIfLessOrEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        default:
+            break;
+    }
+    assert(false && "Opcode doesn't belong to B0 instruction set");
+    return InstructionSet();
+}
@@ -10,6 +10,9 @@
 #include <algorithm>
 #include "address.h"
 #include "full_state.h"
+#include "loop_role.h"
+#include "packed_instruction.h"
+#include "text_format.h"
 
 namespace B1 {
 
@@ -28,6 +31,8 @@ struct Add {
     static Add getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -42,6 +47,8 @@ struct Sub {
     static Sub getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -56,6 +63,8 @@ struct Mul {
     static Mul getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -70,6 +79,8 @@ struct Div {
     static Div getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -83,6 +94,8 @@ struct Move {
     static Move getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -96,6 +109,8 @@ struct Swap {
     static Swap getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -108,6 +123,8 @@ struct Goto {
     static Goto getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -122,6 +139,8 @@ struct JumpIfGreater {
     static JumpIfGreater getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -136,6 +155,8 @@ struct JumpIfLess {
     static JumpIfLess getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -150,6 +171,8 @@ struct JumpIfGreaterOrEqual {
     static JumpIfGreaterOrEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -164,6 +187,8 @@ struct JumpIfLessOrEqual {
     static JumpIfLessOrEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -178,6 +203,8 @@ struct JumpIfEqual {
     static JumpIfEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -191,6 +218,8 @@ struct JumpIfZero {
     static JumpIfZero getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Indirect addressing instructions
@@ -207,6 +236,8 @@ struct LoadIndirect {
     static LoadIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // StoreIndirect: writes to array_type[index_address] where index_address contains the index
@@ -222,6 +253,8 @@ struct StoreIndirect {
     static StoreIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Increment instruction: increases value at address by 1
@@ -235,6 +268,8 @@ struct Inc {
     static Inc getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Decrement instruction: decreases value at address by 1
@@ -248,11 +283,16 @@ struct Dec {
     static Dec getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // B1 instruction set as variant type
 template<unsigned N, unsigned K, unsigned T>
 struct InstructionSet {
+    // Identifier of instruction set in serialized programs
+    static constexpr EInstructionSetId ID = EInstructionSetId::B1;
+
     enum class Type : std::uint8_t {
         Add = 0,
         Sub = 1,
@@ -624,31 +664,85 @@ struct InstructionSet {
     
     // Dump instruction
     std::string dump(unsigned line_number) const {
+        char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+        return std::string(buffer, appendTo(buffer, line_number));
+    }
+    
+    // Append dump of instruction without allocation, buffer must fit MAX_INSTRUCTION_TEXT_SIZE characters
+    char* appendTo(char* output, unsigned line_number) const noexcept {
+        switch (type) {
+            case Type::Add: return storage.add.appendTo(output, line_number);
+            case Type::Sub: return storage.sub.appendTo(output, line_number);
+            case Type::Mul: return storage.mul.appendTo(output, line_number);
+            case Type::Div: return storage.div.appendTo(output, line_number);
+            case Type::Move: return storage.move.appendTo(output, line_number);
+            case Type::Swap: return storage.swap.appendTo(output, line_number);
+            case Type::Goto: return storage.goto_.appendTo(output, line_number);
+            case Type::JumpIfGreater: return storage.jump_if_greater.appendTo(output, line_number);
+            case Type::JumpIfLess: return storage.jump_if_less.appendTo(output, line_number);
+            case Type::JumpIfGreaterOrEqual: return storage.jump_if_greater_or_equal.appendTo(output, line_number);
+            case Type::JumpIfLessOrEqual: return storage.jump_if_less_or_equal.appendTo(output, line_number);
+            case Type::JumpIfEqual: return storage.jump_if_equal.appendTo(output, line_number);
+            case Type::JumpIfZero: return storage.jump_if_zero.appendTo(output, line_number);
+            case Type::LoadIndirect: return storage.load_indirect.appendTo(output, line_number);
+            case Type::StoreIndirect: return storage.store_indirect.appendTo(output, line_number);
+            case Type::Inc: return storage.inc.appendTo(output, line_number);
+            case Type::Dec: return storage.dec.appendTo(output, line_number);
+        }
+        return output;
+    }
+    
+    // Describe instruction for counting loop recognition
+    LoopRole<N, K, T> getLoopRole() const {
+        LoopRole<N, K, T> role;
         switch (type) {
-            case Type::Add: return storage.add.dump(line_number);
-            case Type::Sub: return storage.sub.dump(line_number);
-            case Type::Mul: return storage.mul.dump(line_number);
-            case Type::Div: return storage.div.dump(line_number);
-            case Type::Move: return storage.move.dump(line_number);
-            case Type::Swap: return storage.swap.dump(line_number);
-            case Type::Goto: return storage.goto_.dump(line_number);
-            case Type::JumpIfGreater: return storage.jump_if_greater.dump(line_number);
-            case Type::JumpIfLess: return storage.jump_if_less.dump(line_number);
-            case Type::JumpIfGreaterOrEqual: return storage.jump_if_greater_or_equal.dump(line_number);
-            case Type::JumpIfLessOrEqual: return storage.jump_if_less_or_equal.dump(line_number);
-            case Type::JumpIfEqual: return storage.jump_if_equal.dump(line_number);
-            case Type::JumpIfZero: return storage.jump_if_zero.dump(line_number);
-            case Type::LoadIndirect: return storage.load_indirect.dump(line_number);
-            case Type::StoreIndirect: return storage.store_indirect.dump(line_number);
-            case Type::Inc: return storage.inc.dump(line_number);
-            case Type::Dec: return storage.dec.dump(line_number);
+            case Type::Inc:
+                role.kind = LoopRole<N, K, T>::EKind::Step;
+                role.operand1 = storage.inc.address;
+                role.delta = 1;
+                break;
+            case Type::Dec:
+                role.kind = LoopRole<N, K, T>::EKind::Step;
+                role.operand1 = storage.dec.address;
+                role.delta = -1;
+                break;
+            case Type::Goto:
+                role.kind = LoopRole<N, K, T>::EKind::Goto;
+                role.target = storage.goto_.target;
+                break;
+            case Type::JumpIfZero:
+                role.kind = LoopRole<N, K, T>::EKind::JumpIfZero;
+                role.operand1 = storage.jump_if_zero.operand;
+                role.target = storage.jump_if_zero.target;
+                break;
+            case Type::JumpIfEqual:
+                role.kind = LoopRole<N, K, T>::EKind::JumpIfEqual;
+                role.operand1 = storage.jump_if_equal.operand1;
+                role.operand2 = storage.jump_if_equal.operand2;
+                role.target = storage.jump_if_equal.target;
+                break;
+            default:
+                break;
         }
-        return "";
+        return role;
     }
     
     static std::uint64_t getCombinationCount(unsigned programLen);
     static InstructionSet getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
+    // Encode instruction into packed form
+    PackedInstruction<N, K, T> encode() const;
+    
+    // Check if opcode belongs to this instruction set
+    static bool isSupported(EPackedOpcode opcode) noexcept;
+    
+    // Decode instruction from packed form, opcode must belong to this instruction set
+    static InstructionSet decode(const PackedInstruction<N, K, T>& packed);
+    
+    // Text syntax of instruction produced by dump() after line number, see Assembler for placeholders
+    // Returns null if opcode doesn't belong to this instruction set
+    static const char* getSyntax(EPackedOpcode opcode) noexcept;
+    
 private:
     void destroy() {
         switch (type) {
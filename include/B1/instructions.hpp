@@ -3,10 +3,11 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstdint>
-#include <sstream>
 #include <string>
 #include "address.hpp"
+#include "packed_instruction.hpp"
 
 // Helper functions moved to address.hpp
 
@@ -756,150 +757,263 @@ inline B1::InstructionSet<N, K, T> B1::InstructionSet<N, K, T>::getCombination(s
 // Dump methods for instructions (same as B0 for common instructions)
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Add<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Add " << result.toString() << " = " 
-        << operand1.toString() << " + " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Add<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Add ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " + ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Sub<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Sub " << result.toString() << " = " 
-        << operand1.toString() << " - " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Sub<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Sub ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " - ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Mul<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Mul " << result.toString() << " = " 
-        << operand1.toString() << " * " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Mul<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Mul ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " * ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Div<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Div " << result.toString() << " = " 
-        << operand1.toString() << " / " << operand2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Div<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Div ");
+    output = result.appendTo(output);
+    output = appendText(output, " = ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " / ");
+    output = operand2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Move<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Move " << destination.toString() << " = " 
-        << source.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Move<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Move ");
+    output = destination.appendTo(output);
+    output = appendText(output, " = ");
+    output = source.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Swap<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Swap " << address1.toString() << " <-> " 
-        << address2.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Swap<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Swap ");
+    output = address1.appendTo(output);
+    output = appendText(output, " <-> ");
+    output = address2.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Goto<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Goto " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Goto<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Goto ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfGreater<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfGreater " << operand1.toString() << " > " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfGreater<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfGreater ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " > ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfLess<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfLess " << operand1.toString() << " < " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfLess<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfLess ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " < ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfGreaterOrEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfGreaterOrEqual " << operand1.toString() << " >= " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfGreaterOrEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfGreaterOrEqual ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " >= ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfLessOrEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfLessOrEqual " << operand1.toString() << " <= " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfLessOrEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfLessOrEqual ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " <= ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfEqual " << operand1.toString() << " == " 
-        << operand2.toString() << " -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfEqual ");
+    output = operand1.appendTo(output);
+    output = appendText(output, " == ");
+    output = operand2.appendTo(output);
+    output = appendText(output, " -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::JumpIfZero<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfZero " << operand.toString() << " == 0 -> " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::JumpIfZero<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfZero ");
+    output = operand.appendTo(output);
+    output = appendText(output, " == 0 -> ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::LoadIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    std::string array_type_str;
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            array_type_str = "input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            array_type_str = "output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            array_type_str = "temp";
-            break;
-        default:
-            array_type_str = "unknown";
-            break;
-    }
-    oss << line_number << ": LoadIndirect " << result_address.toString() << " = " 
-        << array_type_str << "[" << index_address.toString() << "]";
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::LoadIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": LoadIndirect ");
+    output = result_address.appendTo(output);
+    output = appendText(output, " = ");
+    output = appendText(output, Address<N, K, T>::getTypeName(array_type));
+    *output++ = '[';
+    output = index_address.appendTo(output);
+    *output++ = ']';
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::StoreIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    std::string array_type_str;
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            array_type_str = "input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            array_type_str = "output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            array_type_str = "temp";
-            break;
-        default:
-            array_type_str = "unknown";
-            break;
-    }
-    oss << line_number << ": StoreIndirect " << array_type_str << "[" 
-        << index_address.toString() << "] = " << value_source.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::StoreIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": StoreIndirect ");
+    output = appendText(output, Address<N, K, T>::getTypeName(array_type));
+    *output++ = '[';
+    output = index_address.appendTo(output);
+    output = appendText(output, "] = ");
+    output = value_source.appendTo(output);
+    return output;
 }
 
 // Inc instruction
@@ -925,9 +1039,16 @@ inline B1::Inc<N, K, T> B1::Inc<N, K, T>::getCombination(std::uint64_t combinati
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Inc<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Inc " << address.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Inc<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Inc ");
+    output = address.appendTo(output);
+    return output;
 }
 
 // Dec instruction
@@ -953,10 +1074,251 @@ inline B1::Dec<N, K, T> B1::Dec<N, K, T>::getCombination(std::uint64_t combinati
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string B1::Dec<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Dec " << address.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* B1::Dec<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Dec ");
+    output = address.appendTo(output);
+    return output;
 }
 
 // Dump method for InstructionSet is already implemented inline in instructions.h
 
+// InstructionSet encode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline PackedInstruction<N, K, T> B1::InstructionSet<N, K, T>::encode() const {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (type) {
+        case Type::Add:
+            return PackedInstructionType::make(EPackedOpcode::Add, PackedInstructionType::packAddress(storage.add.operand1), PackedInstructionType::packAddress(storage.add.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.add.result));
+        case Type::Sub:
+            return PackedInstructionType::make(EPackedOpcode::Sub, PackedInstructionType::packAddress(storage.sub.operand1), PackedInstructionType::packAddress(storage.sub.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.sub.result));
+        case Type::Mul:
+            return PackedInstructionType::make(EPackedOpcode::Mul, PackedInstructionType::packAddress(storage.mul.operand1), PackedInstructionType::packAddress(storage.mul.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.mul.result));
+        case Type::Div:
+            return PackedInstructionType::make(EPackedOpcode::Div, PackedInstructionType::packAddress(storage.div.operand1), PackedInstructionType::packAddress(storage.div.operand2), PackedInstructionType::EAddressType::Input, PackedInstructionType::packAddress(storage.div.result));
+        case Type::Move:
+            return PackedInstructionType::make(EPackedOpcode::Move, PackedInstructionType::packAddress(storage.move.source), PackedInstructionType::packAddress(storage.move.destination));
+        case Type::Swap:
+            return PackedInstructionType::make(EPackedOpcode::Swap, PackedInstructionType::packAddress(storage.swap.address1), PackedInstructionType::packAddress(storage.swap.address2));
+        case Type::Goto:
+            return PackedInstructionType::make(EPackedOpcode::Goto, 0, 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.goto_.target));
+        case Type::JumpIfGreater:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfGreater, PackedInstructionType::packAddress(storage.jump_if_greater.operand1), PackedInstructionType::packAddress(storage.jump_if_greater.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_greater.target));
+        case Type::JumpIfLess:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfLess, PackedInstructionType::packAddress(storage.jump_if_less.operand1), PackedInstructionType::packAddress(storage.jump_if_less.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_less.target));
+        case Type::JumpIfGreaterOrEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfGreaterOrEqual, PackedInstructionType::packAddress(storage.jump_if_greater_or_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_greater_or_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_greater_or_equal.target));
+        case Type::JumpIfLessOrEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfLessOrEqual, PackedInstructionType::packAddress(storage.jump_if_less_or_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_less_or_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_less_or_equal.target));
+        case Type::JumpIfEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfEqual, PackedInstructionType::packAddress(storage.jump_if_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_equal.target));
+        case Type::JumpIfZero:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfZero, PackedInstructionType::packAddress(storage.jump_if_zero.operand), 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_zero.target));
+        case Type::LoadIndirect:
+            return PackedInstructionType::make(EPackedOpcode::LoadIndirect, PackedInstructionType::packAddress(storage.load_indirect.index_address), PackedInstructionType::packAddress(storage.load_indirect.result_address), storage.load_indirect.array_type);
+        case Type::StoreIndirect:
+            return PackedInstructionType::make(EPackedOpcode::StoreIndirect, PackedInstructionType::packAddress(storage.store_indirect.value_source), PackedInstructionType::packAddress(storage.store_indirect.index_address), storage.store_indirect.array_type);
+        case Type::Inc:
+            return PackedInstructionType::make(EPackedOpcode::Inc, PackedInstructionType::packAddress(storage.inc.address));
+        case Type::Dec:
+            return PackedInstructionType::make(EPackedOpcode::Dec, PackedInstructionType::packAddress(storage.dec.address));
+    }
+    return PackedInstructionType{};
+}
+
+// InstructionSet opcode check implementation
+template<unsigned N, unsigned K, unsigned T>
+inline bool B1::InstructionSet<N, K, T>::isSupported(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::Add:
+        case EPackedOpcode::Sub:
+        case EPackedOpcode::Mul:
+        case EPackedOpcode::Div:
+        case EPackedOpcode::Move:
+        case EPackedOpcode::Swap:
+        case EPackedOpcode::Goto:
+        case EPackedOpcode::JumpIfGreater:
+        case EPackedOpcode::JumpIfLess:
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+        case EPackedOpcode::JumpIfLessOrEqual:
+        case EPackedOpcode::JumpIfEqual:
+        case EPackedOpcode::JumpIfZero:
+        case EPackedOpcode::LoadIndirect:
+        case EPackedOpcode::StoreIndirect:
+        case EPackedOpcode::Inc:
+        case EPackedOpcode::Dec:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// InstructionSet syntax implementation
+template<unsigned N, unsigned K, unsigned T>
+inline const char* B1::InstructionSet<N, K, T>::getSyntax(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::Add:
+            return "Add {x} = {1} + {2}";
+        case EPackedOpcode::Sub:
+            return "Sub {x} = {1} - {2}";
+        case EPackedOpcode::Mul:
+            return "Mul {x} = {1} * {2}";
+        case EPackedOpcode::Div:
+            return "Div {x} = {1} / {2}";
+        case EPackedOpcode::Move:
+            return "Move {2} = {1}";
+        case EPackedOpcode::Swap:
+            return "Swap {1} <-> {2}";
+        case EPackedOpcode::Goto:
+            return "Goto {n}";
+        case EPackedOpcode::JumpIfGreater:
+            return "JumpIfGreater {1} > {2} -> {n}";
+        case EPackedOpcode::JumpIfLess:
+            return "JumpIfLess {1} < {2} -> {n}";
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+            return "JumpIfGreaterOrEqual {1} >= {2} -> {n}";
+        case EPackedOpcode::JumpIfLessOrEqual:
+            return "JumpIfLessOrEqual {1} <= {2} -> {n}";
+        case EPackedOpcode::JumpIfEqual:
+            return "JumpIfEqual {1} == {2} -> {n}";
+        case EPackedOpcode::JumpIfZero:
+            return "JumpIfZero {1} == 0 -> {n}";
+        case EPackedOpcode::LoadIndirect:
+            return "LoadIndirect {2} = {a}[{1}]";
+        case EPackedOpcode::StoreIndirect:
+            return "StoreIndirect {a}[{2}] = {1}";
+        case EPackedOpcode::Inc:
+            return "Inc {1}";
+        case EPackedOpcode::Dec:
+            return "Dec {1}";
+        default:
+            return nullptr;
+    }
+}
+
+// InstructionSet decode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline B1::InstructionSet<N, K, T> B1::InstructionSet<N, K, T>::decode(const PackedInstruction<N, K, T>& packed) {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (packed.getOpcode()) {
+        case EPackedOpcode::Add: {
+            Add<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Sub: {
+            Sub<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Mul: {
+            Mul<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Div: {
+            Div<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.result = PackedInstructionType::unpackAddress(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Move: {
+            Move<N, K, T> instruction;
+            instruction.source = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.destination = PackedInstructionType::unpackAddress(packed.getOperand2());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Swap: {
+            Swap<N, K, T> instruction;
+            instruction.address1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.address2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Goto: {
+            Goto<N, K, T> instruction;
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfGreater: {
+            JumpIfGreater<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfLess: {
+            JumpIfLess<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfGreaterOrEqual: {
+            JumpIfGreaterOrEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfLessOrEqual: {
+            JumpIfLessOrEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfEqual: {
+            JumpIfEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfZero: {
+            JumpIfZero<N, K, T> instruction;
+            instruction.operand = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::LoadIndirect: {
+            LoadIndirect<N, K, T> instruction;
+            instruction.index_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.result_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::StoreIndirect: {
+            StoreIndirect<N, K, T> instruction;
+            instruction.value_source = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Inc: {
+            Inc<N, K, T> instruction;
+            instruction.address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Dec: {
+            Dec<N, K, T> instruction;
+            instruction.address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            return InstructionSet(instruction);
+        }
+        default:
+            break;
+    }
+    assert(false && "Opcode doesn't belong to B1 instruction set");
+    return InstructionSet();
+}
@@ -10,6 +10,9 @@
 #include <algorithm>
 #include "address.h"
 #include "full_state.h"
+#include "loop_role.h"
+#include "packed_instruction.h"
+#include "text_format.h"
 
 namespace S0 {
 
@@ -28,6 +31,8 @@ struct SwapIndirect {
     static SwapIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -43,6 +48,8 @@ struct JumpIfLessIndirect {
     static JumpIfLessIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -58,6 +65,8 @@ struct JumpIfGreaterIndirect {
     static JumpIfGreaterIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -73,6 +82,8 @@ struct JumpIfEqualIndirect {
     static JumpIfEqualIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -87,6 +98,8 @@ struct LoadIndirect {
     static LoadIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 template<unsigned N, unsigned K, unsigned T>
@@ -101,6 +114,8 @@ struct StoreIndirect {
     static StoreIndirect getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Increment instruction: increases value at address by 1
@@ -114,6 +129,8 @@ struct Inc {
     static Inc getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Decrement instruction: decreases value at address by 1
@@ -127,6 +144,8 @@ struct Dec {
     static Dec getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // JumpIfEqual instruction: jumps to target if operand1 == operand2
@@ -142,6 +161,8 @@ struct JumpIfEqual {
     static JumpIfEqual getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // JumpIfZero instruction: jumps to target if operand == 0
@@ -156,6 +177,8 @@ struct JumpIfZero {
     static JumpIfZero getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // SetC instruction: sets value at address to a constant
@@ -170,6 +193,8 @@ struct SetC {
     static SetC getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Goto instruction: unconditional jump to target
@@ -183,6 +208,8 @@ struct Goto {
     static Goto getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // Move instruction: copies value from source to destination
@@ -197,11 +224,16 @@ struct Move {
     static Move getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
     std::string dump(unsigned line_number) const;
+    
+    char* appendTo(char* output, unsigned line_number) const noexcept;
 };
 
 // S0 instruction set as custom variant type
 template<unsigned N, unsigned K, unsigned T>
 struct InstructionSet {
+    // Identifier of instruction set in serialized programs
+    static constexpr EInstructionSetId ID = EInstructionSetId::S0;
+
     enum class Type : std::uint8_t {
         SwapIndirect = 0,
         JumpIfLessIndirect = 1,
@@ -501,27 +533,81 @@ struct InstructionSet {
     
     // Dump instruction
     std::string dump(unsigned line_number) const {
+        char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+        return std::string(buffer, appendTo(buffer, line_number));
+    }
+    
+    // Append dump of instruction without allocation, buffer must fit MAX_INSTRUCTION_TEXT_SIZE characters
+    char* appendTo(char* output, unsigned line_number) const noexcept {
+        switch (type) {
+            case Type::SwapIndirect: return storage.swap_indirect.appendTo(output, line_number);
+            case Type::JumpIfLessIndirect: return storage.jump_if_less_indirect.appendTo(output, line_number);
+            case Type::JumpIfGreaterIndirect: return storage.jump_if_greater_indirect.appendTo(output, line_number);
+            case Type::JumpIfEqualIndirect: return storage.jump_if_equal_indirect.appendTo(output, line_number);
+            case Type::LoadIndirect: return storage.load_indirect.appendTo(output, line_number);
+            case Type::StoreIndirect: return storage.store_indirect.appendTo(output, line_number);
+            case Type::Inc: return storage.inc.appendTo(output, line_number);
+            case Type::Dec: return storage.dec.appendTo(output, line_number);
+            case Type::JumpIfEqual: return storage.jump_if_equal.appendTo(output, line_number);
+            case Type::JumpIfZero: return storage.jump_if_zero.appendTo(output, line_number);
+            case Type::SetC: return storage.set_c.appendTo(output, line_number);
+            case Type::Goto: return storage.goto_inst.appendTo(output, line_number);
+            case Type::Move: return storage.move.appendTo(output, line_number);
+        }
+        return output;
+    }
+    
+    // Describe instruction for counting loop recognition
+    LoopRole<N, K, T> getLoopRole() const {
+        LoopRole<N, K, T> role;
         switch (type) {
-            case Type::SwapIndirect: return storage.swap_indirect.dump(line_number);
-            case Type::JumpIfLessIndirect: return storage.jump_if_less_indirect.dump(line_number);
-            case Type::JumpIfGreaterIndirect: return storage.jump_if_greater_indirect.dump(line_number);
-            case Type::JumpIfEqualIndirect: return storage.jump_if_equal_indirect.dump(line_number);
-            case Type::LoadIndirect: return storage.load_indirect.dump(line_number);
-            case Type::StoreIndirect: return storage.store_indirect.dump(line_number);
-            case Type::Inc: return storage.inc.dump(line_number);
-            case Type::Dec: return storage.dec.dump(line_number);
-            case Type::JumpIfEqual: return storage.jump_if_equal.dump(line_number);
-            case Type::JumpIfZero: return storage.jump_if_zero.dump(line_number);
-            case Type::SetC: return storage.set_c.dump(line_number);
-            case Type::Goto: return storage.goto_inst.dump(line_number);
-            case Type::Move: return storage.move.dump(line_number);
+            case Type::Inc:
+                role.kind = LoopRole<N, K, T>::EKind::Step;
+                role.operand1 = storage.inc.address;
+                role.delta = 1;
+                break;
+            case Type::Dec:
+                role.kind = LoopRole<N, K, T>::EKind::Step;
+                role.operand1 = storage.dec.address;
+                role.delta = -1;
+                break;
+            case Type::Goto:
+                role.kind = LoopRole<N, K, T>::EKind::Goto;
+                role.target = storage.goto_inst.target;
+                break;
+            case Type::JumpIfZero:
+                role.kind = LoopRole<N, K, T>::EKind::JumpIfZero;
+                role.operand1 = storage.jump_if_zero.operand;
+                role.target = storage.jump_if_zero.target;
+                break;
+            case Type::JumpIfEqual:
+                role.kind = LoopRole<N, K, T>::EKind::JumpIfEqual;
+                role.operand1 = storage.jump_if_equal.operand1;
+                role.operand2 = storage.jump_if_equal.operand2;
+                role.target = storage.jump_if_equal.target;
+                break;
+            default:
+                break;
         }
-        return "";
+        return role;
     }
     
     static std::uint64_t getCombinationCount(unsigned programLen);
     static InstructionSet getCombination(std::uint64_t combinationIndex, unsigned programLen);
     
+    // Encode instruction into packed form
+    PackedInstruction<N, K, T> encode() const;
+    
+    // Check if opcode belongs to this instruction set
+    static bool isSupported(EPackedOpcode opcode) noexcept;
+    
+    // Decode instruction from packed form, opcode must belong to this instruction set
+    static InstructionSet decode(const PackedInstruction<N, K, T>& packed);
+    
+    // Text syntax of instruction produced by dump() after line number, see Assembler for placeholders
+    // Returns null if opcode doesn't belong to this instruction set
+    static const char* getSyntax(EPackedOpcode opcode) noexcept;
+    
 private:
     void destroy() {
         switch (type) {
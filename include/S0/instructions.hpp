@@ -5,7 +5,8 @@
 
 #include "S0/instructions.h"
 #include "address.hpp"
-#include <sstream>
+#include "packed_instruction.hpp"
+#include <cassert>
 
 namespace S0 {
 
@@ -24,6 +25,21 @@ inline typename Address<N, K, T>::EAddressType decodeArrayType(std::uint64_t ind
     }
 }
 
+// Helper function to get name of array type
+template<unsigned N, unsigned K, unsigned T>
+inline const char* getArrayTypeName(typename Address<N, K, T>::EAddressType array_type) noexcept {
+    switch (array_type) {
+        case Address<N, K, T>::EAddressType::Input:
+            return "Input";
+        case Address<N, K, T>::EAddressType::Output:
+            return "Output";
+        case Address<N, K, T>::EAddressType::Temp:
+            return "Temp";
+        default:
+            return "";
+    }
+}
+
 // Helper function to get array size based on type
 template<unsigned N, unsigned K, unsigned T>
 inline unsigned getArraySize(typename Address<N, K, T>::EAddressType array_type) {
@@ -305,9 +321,16 @@ inline S0::Inc<N, K, T> S0::Inc<N, K, T>::getCombination(std::uint64_t combinati
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::Inc<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Inc " << address.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::Inc<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Inc ");
+    output = address.appendTo(output);
+    return output;
 }
 
 // Dec implementation
@@ -333,9 +356,16 @@ inline S0::Dec<N, K, T> S0::Dec<N, K, T>::getCombination(std::uint64_t combinati
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::Dec<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Dec " << address.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::Dec<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Dec ");
+    output = address.appendTo(output);
+    return output;
 }
 
 // JumpIfEqual implementation
@@ -374,10 +404,20 @@ inline S0::JumpIfEqual<N, K, T> S0::JumpIfEqual<N, K, T>::getCombination(std::ui
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::JumpIfEqual<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfEqual " << operand1.toString() 
-        << " " << operand2.toString() << " " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::JumpIfEqual<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfEqual ");
+    output = operand1.appendTo(output);
+    *output++ = ' ';
+    output = operand2.appendTo(output);
+    *output++ = ' ';
+    output = appendNumber(output, target);
+    return output;
 }
 
 // JumpIfZero implementation
@@ -412,9 +452,18 @@ inline S0::JumpIfZero<N, K, T> S0::JumpIfZero<N, K, T>::getCombination(std::uint
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::JumpIfZero<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfZero " << operand.toString() << " " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::JumpIfZero<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfZero ");
+    output = operand.appendTo(output);
+    *output++ = ' ';
+    output = appendNumber(output, target);
+    return output;
 }
 
 // SetC implementation
@@ -446,9 +495,18 @@ inline S0::SetC<N, K, T> S0::SetC<N, K, T>::getCombination(std::uint64_t combina
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::SetC<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": SetC " << address.toString() << " " << static_cast<unsigned>(constant);
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::SetC<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": SetC ");
+    output = address.appendTo(output);
+    *output++ = ' ';
+    output = appendNumber(output, constant);
+    return output;
 }
 
 // Goto implementation
@@ -471,9 +529,16 @@ inline S0::Goto<N, K, T> S0::Goto<N, K, T>::getCombination(std::uint64_t combina
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::Goto<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Goto " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::Goto<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Goto ");
+    output = appendNumber(output, target);
+    return output;
 }
 
 // Move implementation
@@ -504,10 +569,18 @@ inline S0::Move<N, K, T> S0::Move<N, K, T>::getCombination(std::uint64_t combina
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::Move<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": Move " << destination.toString() << " = " 
-        << source.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::Move<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": Move ");
+    output = destination.appendTo(output);
+    output = appendText(output, " = ");
+    output = source.appendTo(output);
+    return output;
 }
 
 // getCombination implementations
@@ -628,119 +701,116 @@ inline S0::StoreIndirect<N, K, T> S0::StoreIndirect<N, K, T>::getCombination(std
 // dump implementations
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::SwapIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": SwapIndirect " << index1_address.toString() 
-        << " " << index2_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::SwapIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": SwapIndirect ");
+    output = index1_address.appendTo(output);
+    *output++ = ' ';
+    output = index2_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::JumpIfLessIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfLessIndirect " << index1_address.toString() 
-        << " " << index2_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    oss << " " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::JumpIfLessIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfLessIndirect ");
+    output = index1_address.appendTo(output);
+    *output++ = ' ';
+    output = index2_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    *output++ = ' ';
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::JumpIfGreaterIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfGreaterIndirect " << index1_address.toString() 
-        << " " << index2_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    oss << " " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::JumpIfGreaterIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfGreaterIndirect ");
+    output = index1_address.appendTo(output);
+    *output++ = ' ';
+    output = index2_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    *output++ = ' ';
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::JumpIfEqualIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": JumpIfEqualIndirect " << index1_address.toString() 
-        << " " << index2_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    oss << " " << target;
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::JumpIfEqualIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": JumpIfEqualIndirect ");
+    output = index1_address.appendTo(output);
+    *output++ = ' ';
+    output = index2_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    *output++ = ' ';
+    output = appendNumber(output, target);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::LoadIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": LoadIndirect " << index_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    oss << " " << result_address.toString();
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::LoadIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": LoadIndirect ");
+    output = index_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    *output++ = ' ';
+    output = result_address.appendTo(output);
+    return output;
 }
 
 template<unsigned N, unsigned K, unsigned T>
 inline std::string S0::StoreIndirect<N, K, T>::dump(unsigned line_number) const {
-    std::ostringstream oss;
-    oss << line_number << ": StoreIndirect " << value_source.toString() 
-        << " " << index_address.toString() << " ";
-    switch (array_type) {
-        case Address<N, K, T>::EAddressType::Input:
-            oss << "Input";
-            break;
-        case Address<N, K, T>::EAddressType::Output:
-            oss << "Output";
-            break;
-        case Address<N, K, T>::EAddressType::Temp:
-            oss << "Temp";
-            break;
-    }
-    return oss.str();
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer, line_number));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline char* S0::StoreIndirect<N, K, T>::appendTo(char* output, unsigned line_number) const noexcept {
+    output = appendNumber(output, line_number);
+    output = appendText(output, ": StoreIndirect ");
+    output = value_source.appendTo(output);
+    *output++ = ' ';
+    output = index_address.appendTo(output);
+    *output++ = ' ';
+    output = appendText(output, getArrayTypeName<N, K, T>(array_type));
+    return output;
 }
 
 // InstructionSet getCombinationCount implementation
@@ -902,5 +972,195 @@ inline S0::InstructionSet<N, K, T> S0::InstructionSet<N, K, T>::getCombination(s
     return SwapIndirect<N, K, T>::getCombination(0, programLen);
 }
 
+// InstructionSet encode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline PackedInstruction<N, K, T> S0::InstructionSet<N, K, T>::encode() const {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (type) {
+        case Type::SwapIndirect:
+            return PackedInstructionType::make(EPackedOpcode::SwapIndirect, PackedInstructionType::packAddress(storage.swap_indirect.index1_address), PackedInstructionType::packAddress(storage.swap_indirect.index2_address), storage.swap_indirect.array_type);
+        case Type::JumpIfLessIndirect:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfLessIndirect, PackedInstructionType::packAddress(storage.jump_if_less_indirect.index1_address), PackedInstructionType::packAddress(storage.jump_if_less_indirect.index2_address), storage.jump_if_less_indirect.array_type, static_cast<unsigned>(storage.jump_if_less_indirect.target));
+        case Type::JumpIfGreaterIndirect:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfGreaterIndirect, PackedInstructionType::packAddress(storage.jump_if_greater_indirect.index1_address), PackedInstructionType::packAddress(storage.jump_if_greater_indirect.index2_address), storage.jump_if_greater_indirect.array_type, static_cast<unsigned>(storage.jump_if_greater_indirect.target));
+        case Type::JumpIfEqualIndirect:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfEqualIndirect, PackedInstructionType::packAddress(storage.jump_if_equal_indirect.index1_address), PackedInstructionType::packAddress(storage.jump_if_equal_indirect.index2_address), storage.jump_if_equal_indirect.array_type, static_cast<unsigned>(storage.jump_if_equal_indirect.target));
+        case Type::LoadIndirect:
+            return PackedInstructionType::make(EPackedOpcode::LoadIndirect, PackedInstructionType::packAddress(storage.load_indirect.index_address), PackedInstructionType::packAddress(storage.load_indirect.result_address), storage.load_indirect.array_type);
+        case Type::StoreIndirect:
+            return PackedInstructionType::make(EPackedOpcode::StoreIndirect, PackedInstructionType::packAddress(storage.store_indirect.value_source), PackedInstructionType::packAddress(storage.store_indirect.index_address), storage.store_indirect.array_type);
+        case Type::Inc:
+            return PackedInstructionType::make(EPackedOpcode::Inc, PackedInstructionType::packAddress(storage.inc.address));
+        case Type::Dec:
+            return PackedInstructionType::make(EPackedOpcode::Dec, PackedInstructionType::packAddress(storage.dec.address));
+        case Type::JumpIfEqual:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfEqual, PackedInstructionType::packAddress(storage.jump_if_equal.operand1), PackedInstructionType::packAddress(storage.jump_if_equal.operand2), PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_equal.target));
+        case Type::JumpIfZero:
+            return PackedInstructionType::make(EPackedOpcode::JumpIfZero, PackedInstructionType::packAddress(storage.jump_if_zero.operand), 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.jump_if_zero.target));
+        case Type::SetC:
+            return PackedInstructionType::make(EPackedOpcode::SetC, PackedInstructionType::packAddress(storage.set_c.address), 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.set_c.constant));
+        case Type::Goto:
+            return PackedInstructionType::make(EPackedOpcode::Goto, 0, 0, PackedInstructionType::EAddressType::Input, static_cast<unsigned>(storage.goto_inst.target));
+        case Type::Move:
+            return PackedInstructionType::make(EPackedOpcode::Move, PackedInstructionType::packAddress(storage.move.source), PackedInstructionType::packAddress(storage.move.destination));
+    }
+    return PackedInstructionType{};
+}
+
+// InstructionSet opcode check implementation
+template<unsigned N, unsigned K, unsigned T>
+inline bool S0::InstructionSet<N, K, T>::isSupported(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::SwapIndirect:
+        case EPackedOpcode::JumpIfLessIndirect:
+        case EPackedOpcode::JumpIfGreaterIndirect:
+        case EPackedOpcode::JumpIfEqualIndirect:
+        case EPackedOpcode::LoadIndirect:
+        case EPackedOpcode::StoreIndirect:
+        case EPackedOpcode::Inc:
+        case EPackedOpcode::Dec:
+        case EPackedOpcode::JumpIfEqual:
+        case EPackedOpcode::JumpIfZero:
+        case EPackedOpcode::SetC:
+        case EPackedOpcode::Goto:
+        case EPackedOpcode::Move:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// InstructionSet syntax implementation
+template<unsigned N, unsigned K, unsigned T>
+inline const char* S0::InstructionSet<N, K, T>::getSyntax(EPackedOpcode opcode) noexcept {
+    switch (opcode) {
+        case EPackedOpcode::SwapIndirect:
+            return "SwapIndirect {1} {2} {a}";
+        case EPackedOpcode::JumpIfLessIndirect:
+            return "JumpIfLessIndirect {1} {2} {a} {n}";
+        case EPackedOpcode::JumpIfGreaterIndirect:
+            return "JumpIfGreaterIndirect {1} {2} {a} {n}";
+        case EPackedOpcode::JumpIfEqualIndirect:
+            return "JumpIfEqualIndirect {1} {2} {a} {n}";
+        case EPackedOpcode::LoadIndirect:
+            return "LoadIndirect {1} {a} {2}";
+        case EPackedOpcode::StoreIndirect:
+            return "StoreIndirect {1} {2} {a}";
+        case EPackedOpcode::Inc:
+            return "Inc {1}";
+        case EPackedOpcode::Dec:
+            return "Dec {1}";
+        case EPackedOpcode::JumpIfEqual:
+            return "JumpIfEqual {1} {2} {n}";
+        case EPackedOpcode::JumpIfZero:
+            return "JumpIfZero {1} {n}";
+        case EPackedOpcode::SetC:
+            return "SetC {1} {n}";
+        case EPackedOpcode::Goto:
+            return "Goto {n}";
+        case EPackedOpcode::Move:
+            return "Move {2} = {1}";
+        default:
+            return nullptr;
+    }
+}
+
+// InstructionSet decode implementation
+template<unsigned N, unsigned K, unsigned T>
+inline S0::InstructionSet<N, K, T> S0::InstructionSet<N, K, T>::decode(const PackedInstruction<N, K, T>& packed) {
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    switch (packed.getOpcode()) {
+        case EPackedOpcode::SwapIndirect: {
+            SwapIndirect<N, K, T> instruction;
+            instruction.index1_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index2_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfLessIndirect: {
+            JumpIfLessIndirect<N, K, T> instruction;
+            instruction.index1_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index2_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfGreaterIndirect: {
+            JumpIfGreaterIndirect<N, K, T> instruction;
+            instruction.index1_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index2_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfEqualIndirect: {
+            JumpIfEqualIndirect<N, K, T> instruction;
+            instruction.index1_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index2_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::LoadIndirect: {
+            LoadIndirect<N, K, T> instruction;
+            instruction.index_address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.result_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::StoreIndirect: {
+            StoreIndirect<N, K, T> instruction;
+            instruction.value_source = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.index_address = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.array_type = packed.getArrayType();
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Inc: {
+            Inc<N, K, T> instruction;
+            instruction.address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Dec: {
+            Dec<N, K, T> instruction;
+            instruction.address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfEqual: {
+            JumpIfEqual<N, K, T> instruction;
+            instruction.operand1 = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.operand2 = PackedInstructionType::unpackAddress(packed.getOperand2());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::JumpIfZero: {
+            JumpIfZero<N, K, T> instruction;
+            instruction.operand = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::SetC: {
+            SetC<N, K, T> instruction;
+            instruction.address = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.constant = static_cast<std::uint8_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Goto: {
+            Goto<N, K, T> instruction;
+            instruction.target = static_cast<std::size_t>(packed.getExtra());
+            return InstructionSet(instruction);
+        }
+        case EPackedOpcode::Move: {
+            Move<N, K, T> instruction;
+            instruction.source = PackedInstructionType::unpackAddress(packed.getOperand1());
+            instruction.destination = PackedInstructionType::unpackAddress(packed.getOperand2());
+            return InstructionSet(instruction);
+        }
+        default:
+            break;
+    }
+    assert(false && "Opcode doesn't belong to S0 instruction set");
+    return InstructionSet();
+}
+
 } // namespace S0
 
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <string>
 #include "full_state.h"
+#include "text_format.h"
 
 // Address structure
 template<unsigned N, unsigned K, unsigned T>
@@ -21,4 +23,10 @@ struct Address {
     void setValue(FullState<N, K, T>& state, std::uint8_t value) const;
     
     std::string toString() const;
+
+    // Append text representation, e.g. "input[0]", see text_format.h
+    char* appendTo(char* output) const noexcept;
+
+    // Name of address type, e.g. "input"
+    static const char* getTypeName(EAddressType type) noexcept;
 };
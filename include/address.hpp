@@ -5,8 +5,8 @@
 
 #include <cstdint>
 #include <string>
-#include <sstream>
 #include "address.h"
+#include "text_format.hpp"
 
 // Helper function to calculate address combinations
 // Each address can be: Input (N options), Output (K options), or Temp (T options)
@@ -73,21 +73,31 @@ inline void Address<N, K, T>::setValue(FullState<N, K, T>& state, std::uint8_t v
 // Get string representation of address
 template<unsigned N, unsigned K, unsigned T>
 inline std::string Address<N, K, T>::toString() const {
-    std::ostringstream oss;
-    switch (address_type) {
+    char buffer[MAX_ADDRESS_TEXT_SIZE];
+    return std::string(buffer, appendTo(buffer));
+}
+
+// Append text representation
+template<unsigned N, unsigned K, unsigned T>
+inline char* Address<N, K, T>::appendTo(char* output) const noexcept {
+    output = appendText(output, getTypeName(address_type));
+    *output++ = '[';
+    output = appendNumber(output, address);
+    *output++ = ']';
+    return output;
+}
+
+// Name of address type
+template<unsigned N, unsigned K, unsigned T>
+inline const char* Address<N, K, T>::getTypeName(EAddressType type) noexcept {
+    switch (type) {
         case EAddressType::Input:
-            oss << "input[" << address << "]";
-            break;
+            return "input";
         case EAddressType::Output:
-            oss << "output[" << address << "]";
-            break;
+            return "output";
         case EAddressType::Temp:
-            oss << "temp[" << address << "]";
-            break;
+            return "temp";
         default:
-            oss << "unknown[" << address << "]";
-            break;
+            return "unknown";
     }
-    return oss.str();
 }
-
@@ -0,0 +1,60 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Monotonic arena for per-search temporaries
+// Memory is handed out by bumping a pointer in large chunks, deallocation does nothing
+// reset() makes all memory available again but keeps the chunks, so a warmed-up arena doesn't touch the global allocator
+// Arena isn't thread-safe, each search or thread should use its own one
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    // Constructors
+    explicit Arena(std::size_t chunk_size_arg = DEFAULT_CHUNK_SIZE);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Release all allocations at once, chunks are kept for reuse
+    void reset() noexcept;
+
+    // Forget peak use, e.g. at the start of a new search
+    void resetPeak() noexcept;
+
+    // Bytes allocated since the last reset, including alignment padding
+    std::size_t getUsedBytes() const noexcept;
+
+    // Maximum of used bytes since construction or the last resetPeak()
+    std::size_t getPeakBytes() const noexcept;
+
+    // Total size of chunks obtained from the global allocator
+    std::size_t getReservedBytes() const noexcept;
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    std::size_t chunk_size;
+    std::vector<Chunk> chunks;
+    std::size_t current_chunk = 0;
+    std::size_t offset = 0;
+    std::size_t used_bytes = 0;
+    std::size_t peak_bytes = 0;
+    std::size_t reserved_bytes = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Construct object which uses memory resource if it is allocator-aware, otherwise construct it normally
+template<typename Type, typename... Args>
+Type makeWithResource(std::pmr::memory_resource* resource, Args&&... args);
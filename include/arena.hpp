@@ -0,0 +1,82 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include "arena.h"
+
+// Constructors
+inline Arena::Arena(std::size_t chunk_size_arg)
+    : chunk_size(chunk_size_arg) {
+}
+
+// Release all allocations at once
+inline void Arena::reset() noexcept {
+    current_chunk = 0;
+    offset = 0;
+    used_bytes = 0;
+}
+
+// Forget peak use
+inline void Arena::resetPeak() noexcept {
+    peak_bytes = used_bytes;
+}
+
+// Bytes allocated since the last reset
+inline std::size_t Arena::getUsedBytes() const noexcept {
+    return used_bytes;
+}
+
+// Maximum of used bytes
+inline std::size_t Arena::getPeakBytes() const noexcept {
+    return peak_bytes;
+}
+
+// Total size of chunks
+inline std::size_t Arena::getReservedBytes() const noexcept {
+    return reserved_bytes;
+}
+
+// Bump allocation from the current chunk, moving to the next (or a new) chunk if it doesn't fit
+inline void* Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    while (true) {
+        if (current_chunk == chunks.size()) {
+            const std::size_t size = std::max(chunk_size, bytes + alignment);
+            chunks.push_back(Chunk{std::make_unique<std::byte[]>(size), size});
+            reserved_bytes += size;
+        }
+
+        Chunk& chunk = chunks[current_chunk];
+        void* pointer = chunk.data.get() + offset;
+        std::size_t space = chunk.size - offset;
+        if (std::align(alignment, bytes, pointer, space)) {
+            const std::size_t new_offset = chunk.size - space + bytes;
+            used_bytes += new_offset - offset;
+            peak_bytes = std::max(peak_bytes, used_bytes);
+            offset = new_offset;
+            return pointer;
+        }
+
+        ++current_chunk;
+        offset = 0;
+    }
+}
+
+// Memory is released only by reset()
+inline void Arena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    static_cast<void>(pointer);
+    static_cast<void>(bytes);
+    static_cast<void>(alignment);
+}
+
+inline bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// Construct object which uses memory resource if it is allocator-aware
+template<typename Type, typename... Args>
+inline Type makeWithResource(std::pmr::memory_resource* resource, Args&&... args) {
+    return std::make_obj_using_allocator<Type>(std::pmr::polymorphic_allocator<std::byte>(resource), std::forward<Args>(args)...);
+}
@@ -0,0 +1,58 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <istream>
+#include <string>
+#include "address.h"
+#include "packed_instruction.h"
+
+// Template class which parses programs from the text produced by Program::dump()
+// Each line holds one instruction: optional line number with colon, then text described by InstructionSet::getSyntax()
+// Line number, if present, must be equal to position of instruction because jump targets refer to positions
+// Text after '#' is a comment, empty lines are skipped
+// Placeholders of syntax:
+// * {1}, {2} - variable like input[0], output[1] or temp[2], packed into operand1 or operand2
+// * {x}      - variable packed into extra field
+// * {n}      - unsigned number packed into extra field: jump target or constant
+// * {a}      - array type input, output or temp in any letter case, packed into array type field
+// Other characters must match as they are, space matches any amount of white space
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+class Assembler {
+public:
+    using InstructionSetType = InstructionSet<N, K, T>;
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    using AddressType = Address<N, K, T>;
+    using EAddressType = typename AddressType::EAddressType;
+
+    // Parse instruction text without line number, returns false and sets error if text is invalid
+    static bool parseInstruction(const std::string& text, InstructionSetType& instruction, std::string& error);
+
+    // Parse program, error is prefixed with line of input
+    template<typename ProgramClass>
+    static bool parseProgram(std::istream& input, ProgramClass& program, std::string& error);
+
+    // Parse program from file
+    template<typename ProgramClass>
+    static bool loadProgram(const std::string& file_name, ProgramClass& program, std::string& error);
+
+private:
+    // Match text with syntax, text is moved past the matched part
+    static bool matchSyntax(const char* syntax, const char*& text, PackedInstructionType& packed, std::string& error);
+
+    // Parse variable and return its flat index
+    static bool parseAddress(const char*& text, unsigned& index, std::string& error);
+
+    // Parse array type
+    static bool parseArrayType(const char*& text, EAddressType& array_type, std::string& error);
+
+    // Parse unsigned number not greater than max_value
+    static bool parseNumber(const char*& text, unsigned max_value, unsigned& value, std::string& error);
+
+    // Parse word of letters
+    static std::string parseWord(const char*& text);
+
+    // Skip white space
+    static void skipSpaces(const char*& text) noexcept;
+};
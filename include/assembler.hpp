@@ -0,0 +1,277 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cctype>
+#include <fstream>
+#include "address.hpp"
+#include "packed_instruction.hpp"
+#include "assembler.h"
+
+// Parse instruction text without line number
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool Assembler<InstructionSet, N, K, T>::parseInstruction(const std::string& text, InstructionSetType& instruction, std::string& error) {
+    const char* position = text.c_str();
+    skipSpaces(position);
+    const char* mnemonic_start = position;
+    const std::string mnemonic = parseWord(position);
+    if (mnemonic.empty()) {
+        error = "Expected instruction name";
+        return false;
+    }
+
+    // Syntax of each opcode starts with its name
+    for (unsigned code = 0; code <= static_cast<unsigned>(EPackedOpcode::SetC); ++code) {
+        const EPackedOpcode opcode = static_cast<EPackedOpcode>(code);
+        const char* syntax = InstructionSetType::getSyntax(opcode);
+        if (syntax == nullptr) {
+            continue;
+        }
+        const char* syntax_position = syntax;
+        if (parseWord(syntax_position) != mnemonic) {
+            continue;
+        }
+
+        PackedInstructionType packed = PackedInstructionType::make(opcode);
+        position = mnemonic_start;
+        if (!matchSyntax(syntax, position, packed, error)) {
+            error = mnemonic + ": " + error + " (syntax \"" + syntax + "\")";
+            return false;
+        }
+        skipSpaces(position);
+        if (*position != '\0') {
+            error = mnemonic + ": unexpected text \"" + position + "\" (syntax \"" + syntax + "\")";
+            return false;
+        }
+
+        // Values which don't fit into instruction fields are changed by decoding
+        instruction = InstructionSetType::decode(packed);
+        if (instruction.encode().word != packed.word) {
+            error = mnemonic + ": value out of range";
+            return false;
+        }
+        return true;
+    }
+    error = "Unknown instruction " + mnemonic;
+    return false;
+}
+
+// Parse program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool Assembler<InstructionSet, N, K, T>::parseProgram(std::istream& input, ProgramClass& program, std::string& error) {
+    program.clear();
+    std::string line;
+    unsigned line_index = 0;
+    while (std::getline(input, line)) {
+        ++line_index;
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.resize(comment);
+        }
+        const char* position = line.c_str();
+        skipSpaces(position);
+        if (*position == '\0') {
+            continue;
+        }
+
+        const std::string prefix = "Line " + std::to_string(line_index) + ": ";
+        if (std::isdigit(static_cast<unsigned char>(*position))) {
+            unsigned line_number = 0;
+            if (!parseNumber(position, PackedInstructionType::MAX_EXTRA, line_number, error)) {
+                error = prefix + error;
+                return false;
+            }
+            skipSpaces(position);
+            if (*position != ':') {
+                error = prefix + "expected ':' after line number";
+                return false;
+            }
+            ++position;
+            if (line_number != program.size()) {
+                error = prefix + "line number " + std::to_string(line_number) + " differs from instruction position " + std::to_string(program.size());
+                return false;
+            }
+        }
+
+        InstructionSetType instruction;
+        if (!parseInstruction(position, instruction, error)) {
+            error = prefix + error;
+            return false;
+        }
+        program.add(instruction);
+    }
+    return true;
+}
+
+// Parse program from file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool Assembler<InstructionSet, N, K, T>::loadProgram(const std::string& file_name, ProgramClass& program, std::string& error) {
+    std::ifstream input(file_name);
+    if (!input.is_open()) {
+        error = "Can't open " + file_name;
+        return false;
+    }
+    if (!parseProgram(input, program, error)) {
+        error = file_name + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+// Match text with syntax
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool Assembler<InstructionSet, N, K, T>::matchSyntax(const char* syntax, const char*& text, PackedInstructionType& packed, std::string& error) {
+    unsigned operand1 = 0;
+    unsigned operand2 = 0;
+    unsigned extra = 0;
+    EAddressType array_type = EAddressType::Input;
+
+    while (*syntax != '\0') {
+        if (*syntax == ' ') {
+            skipSpaces(text);
+            ++syntax;
+            continue;
+        }
+        if (*syntax != '{') {
+            if (*text != *syntax) {
+                error = std::string("expected '") + *syntax + "'";
+                return false;
+            }
+            ++text;
+            ++syntax;
+            continue;
+        }
+
+        const char placeholder = syntax[1];
+        syntax += 3;
+        bool parsed = false;
+        switch (placeholder) {
+            case '1':
+                parsed = parseAddress(text, operand1, error);
+                break;
+            case '2':
+                parsed = parseAddress(text, operand2, error);
+                break;
+            case 'x':
+                parsed = parseAddress(text, extra, error);
+                break;
+            case 'n':
+                parsed = parseNumber(text, PackedInstructionType::MAX_EXTRA, extra, error);
+                break;
+            case 'a':
+                parsed = parseArrayType(text, array_type, error);
+                break;
+            default:
+                error = "invalid syntax";
+                break;
+        }
+        if (!parsed) {
+            return false;
+        }
+    }
+
+    packed = PackedInstructionType::make(packed.getOpcode(), operand1, operand2, array_type, extra);
+    return true;
+}
+
+// Parse variable
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool Assembler<InstructionSet, N, K, T>::parseAddress(const char*& text, unsigned& index, std::string& error) {
+    EAddressType address_type = EAddressType::Input;
+    const std::string type_name = parseWord(text);
+    unsigned count = 0;
+    if (type_name == "input") {
+        address_type = EAddressType::Input;
+        count = N;
+    } else if (type_name == "output") {
+        address_type = EAddressType::Output;
+        count = K;
+    } else if (type_name == "temp") {
+        address_type = EAddressType::Temp;
+        count = T;
+    } else {
+        error = type_name.empty() ? "expected variable" : "unknown variable type " + type_name;
+        return false;
+    }
+    if (*text != '[') {
+        error = "expected '[' after " + type_name;
+        return false;
+    }
+    ++text;
+    unsigned address = 0;
+    if (!parseNumber(text, PackedInstructionType::MAX_VARIABLE_COUNT, address, error)) {
+        return false;
+    }
+    if (*text != ']') {
+        error = "expected ']' after " + type_name + " index";
+        return false;
+    }
+    ++text;
+    if (address >= count) {
+        error = type_name + "[" + std::to_string(address) + "] is out of range, count of " + type_name + " variables is " + std::to_string(count);
+        return false;
+    }
+    index = PackedInstructionType::packAddress(AddressType{address_type, address});
+    return true;
+}
+
+// Parse array type
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool Assembler<InstructionSet, N, K, T>::parseArrayType(const char*& text, EAddressType& array_type, std::string& error) {
+    std::string type_name = parseWord(text);
+    for (char& symbol : type_name) {
+        symbol = static_cast<char>(std::tolower(static_cast<unsigned char>(symbol)));
+    }
+    if (type_name == "input") {
+        array_type = EAddressType::Input;
+    } else if (type_name == "output") {
+        array_type = EAddressType::Output;
+    } else if (type_name == "temp") {
+        array_type = EAddressType::Temp;
+    } else {
+        error = "expected array type input, output or temp";
+        return false;
+    }
+    return true;
+}
+
+// Parse unsigned number
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool Assembler<InstructionSet, N, K, T>::parseNumber(const char*& text, unsigned max_value, unsigned& value, std::string& error) {
+    if (!std::isdigit(static_cast<unsigned char>(*text))) {
+        error = "expected number";
+        return false;
+    }
+    value = 0;
+    while (std::isdigit(static_cast<unsigned char>(*text))) {
+        value = value * 10 + static_cast<unsigned>(*text - '0');
+        if (value > max_value) {
+            error = "number is greater than " + std::to_string(max_value);
+            return false;
+        }
+        ++text;
+    }
+    return true;
+}
+
+// Parse word of letters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::string Assembler<InstructionSet, N, K, T>::parseWord(const char*& text) {
+    std::string word;
+    while (std::isalpha(static_cast<unsigned char>(*text))) {
+        word += *text;
+        ++text;
+    }
+    return word;
+}
+
+// Skip white space
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void Assembler<InstructionSet, N, K, T>::skipSpaces(const char*& text) noexcept {
+    while (std::isspace(static_cast<unsigned char>(*text))) {
+        ++text;
+    }
+}
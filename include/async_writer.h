@@ -0,0 +1,133 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "spsc_queue.h"
+
+// Background writer of output files, so the search thread never waits for file I/O
+// Each open file is a channel; bytes written to a channel are collected into batches of batch_size on the calling thread,
+// full batches go to the writer thread through bounded lock-free queue and are written with one large write each
+// All methods must be called from one producer thread; the producer waits only if the queue is full or on flush()
+class AsyncWriter {
+public:
+    using ChannelId = std::uint32_t;
+
+    // Converter of batch of records into bytes written to file, it runs on the writer thread
+    // Records written by one write() call are never split between batches
+    using FormatterType = std::function<void(const std::uint8_t* data, std::size_t size, std::string& output)>;
+
+    // Default count of batches in flight and default batch size
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 64;
+    static constexpr std::size_t DEFAULT_BATCH_SIZE = 1 << 16;
+
+    // Constructors
+    // Writer thread is started by the first addChannel()
+    explicit AsyncWriter(std::size_t queue_capacity = DEFAULT_QUEUE_CAPACITY, std::size_t batch_size_arg = DEFAULT_BATCH_SIZE);
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    // Take over open file, bytes written to the returned channel are passed through formatter if it isn't empty
+    ChannelId addChannel(std::ofstream&& stream, FormatterType formatter = FormatterType());
+
+    // Append bytes to channel
+    void write(ChannelId channel, const void* data, std::size_t size);
+    void write(ChannelId channel, const std::string& text);
+
+    // Checkpoint: pass pending batches of all channels to the writer thread and wait until they are written and flushed
+    void flush();
+
+    // Write pending batch of channel and close its file, returns after the file is closed
+    void closeChannel(ChannelId channel);
+
+    // Write pending batches, close all files and stop the writer thread
+    void close();
+
+    // Check if the writer thread is running
+    bool isRunning() const noexcept;
+
+    // Check if writing, flushing or closing file of channel failed on the writer thread, e.g. disk is full
+    // Result is exact after flush() or closeChannel(), channel ids are valid until close()
+    bool hasFailed(ChannelId channel) const noexcept;
+
+    // Count of batches passed to the writer thread
+    std::uint64_t getBatchCount() const noexcept;
+
+    // Count of times the producer waited for the writer thread because the queue was full
+    std::uint64_t getStallCount() const noexcept;
+
+private:
+    enum class ECommand {
+        AddChannel,
+        Write,
+        Flush,
+        CloseChannel,
+        Stop
+    };
+
+    // File owned by the writer thread
+    struct Channel {
+        std::ofstream stream;
+        FormatterType formatter;
+        std::string formatted;
+        std::atomic<bool>* failed = nullptr; // Owned by PendingBatch of the channel
+    };
+
+    struct Message {
+        ECommand command = ECommand::Write;
+        ChannelId channel = 0;
+        std::string data;                    // Batch of Write
+        std::unique_ptr<Channel> new_channel; // File of AddChannel
+        std::uint64_t flush_number = 0;      // Number of Flush
+    };
+
+    // Batch being collected by the producer
+    struct PendingBatch {
+        std::string data;
+        bool open = false;
+        std::unique_ptr<std::atomic<bool>> failed; // Set by the writer thread, address is stable when pending grows
+    };
+
+    std::size_t batch_size;
+    SpscQueue<Message> messages;
+    SpscQueue<std::string> free_buffers; // Written batches returned to the producer for reuse
+    std::thread thread;
+    bool running = false;
+
+    // Producer state
+    std::vector<PendingBatch> pending;
+    std::uint64_t requested_flushes = 0;
+    std::uint64_t batch_count = 0;
+    std::uint64_t stall_count = 0;
+
+    // Counters which wake up the other side
+    std::atomic<std::uint64_t> pushed_count{0};
+    std::atomic<std::uint64_t> popped_count{0};
+    std::atomic<std::uint64_t> completed_flushes{0};
+
+    // Producer: pass message to the writer thread, waits while the queue is full
+    void push(Message& message);
+
+    // Producer: pass pending batch of channel to the writer thread
+    void submitBatch(ChannelId channel);
+
+    // Producer: empty buffer for the next batch
+    std::string takeBuffer();
+
+    // Body of the writer thread
+    void run();
+
+    // Writer thread: remember failure of the last operation on file of channel
+    static void checkStream(Channel& channel);
+};
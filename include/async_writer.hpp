@@ -0,0 +1,223 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include <utility>
+#include "async_writer.h"
+#include "spsc_queue.hpp"
+
+// Constructors
+inline AsyncWriter::AsyncWriter(std::size_t queue_capacity, std::size_t batch_size_arg)
+    : batch_size(batch_size_arg), messages(queue_capacity), free_buffers(queue_capacity) {
+}
+
+inline AsyncWriter::~AsyncWriter() {
+    close();
+}
+
+// Take over open file
+inline AsyncWriter::ChannelId AsyncWriter::addChannel(std::ofstream&& stream, FormatterType formatter) {
+    if (!running) {
+        running = true;
+        thread = std::thread(&AsyncWriter::run, this);
+    }
+    const ChannelId channel = static_cast<ChannelId>(pending.size());
+    pending.push_back(PendingBatch{takeBuffer(), true, std::make_unique<std::atomic<bool>>(false)});
+
+    Message message;
+    message.command = ECommand::AddChannel;
+    message.channel = channel;
+    message.new_channel = std::make_unique<Channel>();
+    message.new_channel->stream = std::move(stream);
+    message.new_channel->formatter = std::move(formatter);
+    message.new_channel->failed = pending.back().failed.get();
+    push(message);
+    return channel;
+}
+
+// Append bytes to channel
+inline void AsyncWriter::write(ChannelId channel, const void* data, std::size_t size) {
+    assert(channel < pending.size() && pending[channel].open);
+    std::string& batch = pending[channel].data;
+    batch.append(static_cast<const char*>(data), size);
+    if (batch.size() >= batch_size) {
+        submitBatch(channel);
+    }
+}
+
+inline void AsyncWriter::write(ChannelId channel, const std::string& text) {
+    write(channel, text.data(), text.size());
+}
+
+// Checkpoint
+inline void AsyncWriter::flush() {
+    if (!running) {
+        return;
+    }
+    for (ChannelId channel = 0; channel < pending.size(); ++channel) {
+        submitBatch(channel);
+    }
+    Message message;
+    message.command = ECommand::Flush;
+    message.flush_number = ++requested_flushes;
+    push(message);
+
+    std::uint64_t completed = completed_flushes.load(std::memory_order_acquire);
+    while (completed < requested_flushes) {
+        completed_flushes.wait(completed, std::memory_order_acquire);
+        completed = completed_flushes.load(std::memory_order_acquire);
+    }
+}
+
+// Write pending batch of channel and close its file
+inline void AsyncWriter::closeChannel(ChannelId channel) {
+    assert(channel < pending.size() && pending[channel].open);
+    submitBatch(channel);
+    pending[channel].open = false;
+
+    Message message;
+    message.command = ECommand::CloseChannel;
+    message.channel = channel;
+    push(message);
+    // File may be reopened by the caller right after return
+    flush();
+}
+
+// Close all files and stop the writer thread
+inline void AsyncWriter::close() {
+    if (!running) {
+        return;
+    }
+    for (ChannelId channel = 0; channel < pending.size(); ++channel) {
+        submitBatch(channel);
+    }
+    Message message;
+    message.command = ECommand::Stop;
+    push(message);
+    thread.join();
+    running = false;
+    pending.clear();
+}
+
+// Check if the writer thread is running
+inline bool AsyncWriter::isRunning() const noexcept {
+    return running;
+}
+
+// Check if file of channel failed
+inline bool AsyncWriter::hasFailed(ChannelId channel) const noexcept {
+    // Writer thread sets the flag before it completes the flush which the producer waits for
+    return channel < pending.size() && pending[channel].failed->load(std::memory_order_relaxed);
+}
+
+// Count of batches passed to the writer thread
+inline std::uint64_t AsyncWriter::getBatchCount() const noexcept {
+    return batch_count;
+}
+
+// Count of times the producer waited for the writer thread
+inline std::uint64_t AsyncWriter::getStallCount() const noexcept {
+    return stall_count;
+}
+
+// Pass message to the writer thread
+inline void AsyncWriter::push(Message& message) {
+    while (true) {
+        const std::uint64_t popped = popped_count.load(std::memory_order_acquire);
+        if (messages.tryPush(message)) {
+            break;
+        }
+        ++stall_count;
+        popped_count.wait(popped, std::memory_order_acquire);
+    }
+    pushed_count.fetch_add(1, std::memory_order_release);
+    pushed_count.notify_one();
+}
+
+// Pass pending batch of channel to the writer thread
+inline void AsyncWriter::submitBatch(ChannelId channel) {
+    PendingBatch& batch = pending[channel];
+    if (batch.data.empty()) {
+        return;
+    }
+    Message message;
+    message.command = ECommand::Write;
+    message.channel = channel;
+    message.data = std::move(batch.data);
+    batch.data = takeBuffer();
+    push(message);
+    ++batch_count;
+}
+
+// Empty buffer for the next batch
+inline std::string AsyncWriter::takeBuffer() {
+    std::string buffer;
+    free_buffers.tryPop(buffer);
+    buffer.clear();
+    buffer.reserve(batch_size);
+    return buffer;
+}
+
+// Body of the writer thread
+inline void AsyncWriter::run() {
+    std::vector<std::unique_ptr<Channel>> channels;
+    Message message;
+    while (true) {
+        const std::uint64_t pushed = pushed_count.load(std::memory_order_acquire);
+        if (!messages.tryPop(message)) {
+            pushed_count.wait(pushed, std::memory_order_acquire);
+            continue;
+        }
+        popped_count.fetch_add(1, std::memory_order_release);
+        popped_count.notify_one();
+
+        switch (message.command) {
+            case ECommand::AddChannel:
+                assert(message.channel == channels.size());
+                channels.push_back(std::move(message.new_channel));
+                break;
+            case ECommand::Write: {
+                Channel& channel = *channels[message.channel];
+                if (channel.formatter) {
+                    channel.formatted.clear();
+                    channel.formatter(reinterpret_cast<const std::uint8_t*>(message.data.data()), message.data.size(), channel.formatted);
+                    channel.stream.write(channel.formatted.data(), static_cast<std::streamsize>(channel.formatted.size()));
+                } else {
+                    channel.stream.write(message.data.data(), static_cast<std::streamsize>(message.data.size()));
+                }
+                checkStream(channel);
+                // Buffer is dropped if the producer already holds enough spare ones
+                message.data.clear();
+                free_buffers.tryPush(message.data);
+                break;
+            }
+            case ECommand::Flush:
+                for (const std::unique_ptr<Channel>& channel : channels) {
+                    if (channel) {
+                        channel->stream.flush();
+                        checkStream(*channel);
+                    }
+                }
+                completed_flushes.store(message.flush_number, std::memory_order_release);
+                completed_flushes.notify_all();
+                break;
+            case ECommand::CloseChannel:
+                channels[message.channel]->stream.close();
+                checkStream(*channels[message.channel]);
+                channels[message.channel].reset();
+                break;
+            case ECommand::Stop:
+                // Files are flushed and closed by destructors of channels
+                return;
+        }
+    }
+}
+
+// Remember failure of the last operation on file of channel
+inline void AsyncWriter::checkStream(Channel& channel) {
+    if (!channel.stream) {
+        channel.failed->store(true, std::memory_order_relaxed);
+    }
+}
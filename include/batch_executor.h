@@ -0,0 +1,178 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "cost_model.h"
+#include "full_state.h"
+#include "loop_accelerator.h"
+#include "program.h"
+#include "step_histogram.h"
+#include "step_objective.h"
+#include "variables.h"
+
+// Template class for executing a batch of candidate programs of the same length on one input
+// Instructions are stored position-major (SoA): all candidates' instructions for position 0, then position 1, etc.
+// Each candidate runs under its own rabbit/turtle pair, so step counts, costs and infinite loop detection
+// are exactly the same as with RabbitTurtle
+// Without cost model, candidates with recognised counting loops are run by their own LoopAccelerator instead,
+// their step count is derived from executed instruction count as in Optimize::executeAndCountSteps()
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class BatchExecutor {
+public:
+    using ProgramType = ProgramClass;
+    using InstructionSetType = InstructionSet<N, K, T>;
+    using InputVariablesType = InputVariables<N>;
+    using OutputVariablesType = OutputVariables<K>;
+    using FullStateType = FullState<N, K, T>;
+    using LoopAcceleratorType = LoopAccelerator<InstructionSet, N, K, T, ProgramClass>;
+
+    // Reason why candidate became invalid
+    enum class ERejectReason : std::uint8_t {
+        None,
+        OutputMismatch,      // Output differs from the reference on some input
+        TerminationMismatch, // Candidate loops where the reference finishes or vice versa
+        CostBound            // Value of objective reached the cost bound
+    };
+
+    // Verification result of one candidate
+    struct CandidateResult {
+        bool valid = true;
+        ERejectReason reject_reason = ERejectReason::None;
+        std::uint64_t total_steps = 0;       // Total step count, or total cost if cost model is set
+        std::uint64_t worst_steps = 0;       // Largest step count or cost of one input
+        std::uint64_t over_bound_inputs = 0; // Count of inputs whose step count or cost reached the cost bound
+    };
+
+    // Work done since the last start()
+    struct Counters {
+        std::uint64_t inputs_executed = 0;       // Candidate runs, one per candidate and input
+        std::uint64_t instructions_executed = 0; // Instructions executed by rabbits and turtles
+        std::uint64_t cycle_checks = 0;          // Rabbit and turtle state comparisons
+        std::uint64_t accelerated_runs = 0;      // Runs finished by closed-form evaluation, their instructions aren't counted
+    };
+
+    // Constructors
+    BatchExecutor(unsigned program_len_arg, std::size_t capacity_arg, std::uint64_t max_steps_arg);
+
+    // Access to batch parameters
+    unsigned getProgramLen() const noexcept;
+    std::size_t getCapacity() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+    bool full() const noexcept;
+
+    // Remove all candidates
+    void clear() noexcept;
+
+    // Load candidate program, its length must be equal to getProgramLen()
+    // Candidate with recognised counting loops gets its own accelerator if cost model isn't set
+    // Returns index of the candidate in the batch
+    std::size_t add(const ProgramType& program);
+
+    // Access to loaded candidate instruction
+    const InstructionSetType& getInstruction(std::size_t candidate_index, std::size_t position) const;
+
+    // Gather loaded candidate back into a program
+    ProgramType getProgram(std::size_t candidate_index) const;
+
+    // Gather loaded candidate back into a program allocated from resource, if program type is allocator-aware
+    ProgramType getProgram(std::size_t candidate_index, std::pmr::memory_resource* resource) const;
+
+    // Accelerators of loaded candidates are allocated from resource, e.g. from per-batch Arena
+    // It must be set while the batch is empty and must not be reset before clear()
+    void setMemoryResource(std::pmr::memory_resource* resource_arg);
+
+    // Weigh instructions executed by rabbit by cost model instead of counting steps, null counts steps
+    // It must be set while the batch is empty, model must outlive the batch
+    void setCostModel(const CostModel* cost_model_arg);
+    const CostModel* getCostModel() const noexcept;
+
+    // Aggregate of per-input step counts or costs used by cost bound and getObjectiveValue(), total by default
+    // input_count is count of inputs passed to execute() after each start(), percentile bound relies on it
+    void setObjective(const StepObjective& objective_arg, std::uint64_t input_count);
+    const StepObjective& getObjective() const noexcept;
+
+    // Candidates whose value of objective reaches cost bound are rejected, no bound by default
+    // Under max and percentile objectives a run is stopped as soon as it makes the candidate reach the bound
+    void setCostBound(std::uint64_t cost_bound_arg) noexcept;
+    std::uint64_t getCostBound() const noexcept;
+
+    // Reset verification results and counters of all loaded candidates
+    void start();
+
+    // Run all still valid candidates on input and compare with reference output
+    // Candidates whose output or termination differs from the reference become invalid
+    void execute(const InputVariablesType& input, const OutputVariablesType& reference_output, bool reference_infinite_loop);
+
+    // Check if at least one candidate is still valid
+    bool hasValidCandidates() const noexcept;
+
+    // Access to verification results
+    const CandidateResult& getResult(std::size_t candidate_index) const;
+
+    // Value of objective of candidate, it is final after the last execute()
+    std::uint64_t getObjectiveValue(std::size_t candidate_index) const;
+
+    // Access to work counters
+    const Counters& getCounters() const noexcept;
+
+private:
+    enum class ELaneStatus : std::uint8_t {
+        Running,
+        Finished,
+        InfiniteLoop,
+        OverBound // Stopped because its step count or cost reached the bound, see LaneState::limit
+    };
+
+    struct LaneState {
+        FullStateType rabbit;
+        FullStateType turtle;
+        std::uint64_t steps = 0;
+        std::uint64_t cost = 0;
+        std::uint64_t limit = 0; // Step count or cost which makes the candidate reach the cost bound
+        ELaneStatus status = ELaneStatus::Running;
+    };
+
+    unsigned program_len;
+    std::size_t capacity;
+    std::uint64_t max_steps;
+    std::uint64_t cost_bound = std::numeric_limits<std::uint64_t>::max();
+    const CostModel* cost_model = nullptr;
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+    StepObjective objective;
+    std::uint64_t allowed_over_bound = std::numeric_limits<std::uint64_t>::max();
+    std::size_t count = 0;
+    std::size_t valid_count = 0;
+    Counters counters;
+
+    // instructions[position * capacity + candidate_index]
+    std::vector<InstructionSetType> instructions;
+    // costs[position * capacity + candidate_index], filled only if cost model is set
+    std::vector<CostModel::Cost> costs;
+    std::vector<CandidateResult> results;
+    std::vector<StepHistogram> histograms; // Per-candidate values of inputs, allocated only if objective needs them
+    std::vector<LaneState> lanes;
+    std::vector<std::size_t> active_lanes;
+    std::vector<ProgramType> accelerated_programs;                // Copies of accelerated candidates, accelerators refer to them
+    std::vector<std::optional<LoopAcceleratorType>> accelerators; // Set only for candidates with recognised counting loops
+
+    // Run candidate by its accelerator, returns false if it has to be stepped, e.g. it doesn't finish
+    bool runAccelerated(std::size_t candidate_index, const InputVariablesType& input);
+
+    // Make one RabbitTurtle iteration of all active lanes, finished lanes are removed
+    template<bool WEIGHTED>
+    void stepActiveLanes();
+
+    // Execute one instruction of the candidate, returns false if candidate is finished
+    bool step(std::size_t candidate_index, FullStateType& state);
+
+    // Same as above, but also add cost of the executed instruction
+    bool step(std::size_t candidate_index, FullStateType& state, std::uint64_t& cost);
+};
@@ -0,0 +1,362 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include "arena.hpp"
+#include "batch_executor.h"
+#include "cost_model.hpp"
+#include "loop_accelerator.hpp"
+#include "step_histogram.hpp"
+#include "step_objective.hpp"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline BatchExecutor<InstructionSet, N, K, T, ProgramClass>::BatchExecutor(unsigned program_len_arg, std::size_t capacity_arg, std::uint64_t max_steps_arg)
+    : program_len(program_len_arg), capacity(capacity_arg), max_steps(max_steps_arg),
+      instructions(static_cast<std::size_t>(program_len_arg) * capacity_arg), results(capacity_arg), lanes(capacity_arg) {
+    active_lanes.reserve(capacity);
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        accelerated_programs.resize(capacity);
+        accelerators.resize(capacity);
+    }
+}
+
+// Access to batch parameters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline unsigned BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getProgramLen() const noexcept {
+    return program_len;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getCapacity() const noexcept {
+    return capacity;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t BatchExecutor<InstructionSet, N, K, T, ProgramClass>::size() const noexcept {
+    return count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::empty() const noexcept {
+    return count == 0;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::full() const noexcept {
+    return count == capacity;
+}
+
+// Remove all candidates
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::clear() noexcept {
+    // Accelerators are released before their memory resource may be reset
+    for (std::size_t i = 0; i < count && i < accelerators.size(); ++i) {
+        accelerators[i].reset();
+    }
+    count = 0;
+    valid_count = 0;
+}
+
+// Load candidate program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t BatchExecutor<InstructionSet, N, K, T, ProgramClass>::add(const ProgramType& program) {
+    assert(count < capacity);
+    assert(program.size() == program_len);
+    for (std::size_t position = 0; position < program_len; ++position) {
+        instructions[position * capacity + count] = program[position];
+    }
+    if (cost_model) {
+        for (std::size_t position = 0; position < program_len; ++position) {
+            costs[position * capacity + count] = cost_model->getCost(program[position]);
+        }
+    }
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        accelerators[count].reset();
+        // Accelerator knows only instruction count, so weighted candidates are always stepped
+        // Program passed here is usually reused by the caller, so accelerator is built again over own copy
+        if (!cost_model && LoopAcceleratorType(program, resource).isAccelerated()) {
+            accelerated_programs[count] = program;
+            accelerators[count].emplace(accelerated_programs[count], resource);
+        }
+    }
+    return count++;
+}
+
+// Access to loaded candidate instruction
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename BatchExecutor<InstructionSet, N, K, T, ProgramClass>::InstructionSetType& BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getInstruction(std::size_t candidate_index, std::size_t position) const {
+    assert(candidate_index < count && position < program_len);
+    return instructions[position * capacity + candidate_index];
+}
+
+// Gather loaded candidate back into a program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename BatchExecutor<InstructionSet, N, K, T, ProgramClass>::ProgramType BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getProgram(std::size_t candidate_index) const {
+    ProgramType program(program_len);
+    for (std::size_t position = 0; position < program_len; ++position) {
+        program.add(getInstruction(candidate_index, position));
+    }
+    return program;
+}
+
+// Gather loaded candidate back into a program allocated from resource
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename BatchExecutor<InstructionSet, N, K, T, ProgramClass>::ProgramType BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getProgram(std::size_t candidate_index, std::pmr::memory_resource* resource) const {
+    ProgramType program = makeWithResource<ProgramType>(resource);
+    program.reserve(program_len);
+    for (std::size_t position = 0; position < program_len; ++position) {
+        program.add(getInstruction(candidate_index, position));
+    }
+    return program;
+}
+
+// Memory resource of accelerators
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::setMemoryResource(std::pmr::memory_resource* resource_arg) {
+    assert(count == 0);
+    resource = resource_arg;
+}
+
+// Cost model
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::setCostModel(const CostModel* cost_model_arg) {
+    assert(count == 0);
+    cost_model = cost_model_arg;
+    costs.resize(cost_model ? instructions.size() : 0);
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const CostModel* BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getCostModel() const noexcept {
+    return cost_model;
+}
+
+// Objective
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::setObjective(const StepObjective& objective_arg, std::uint64_t input_count) {
+    objective = objective_arg;
+    allowed_over_bound = objective.getAllowedOverBound(input_count);
+    if (objective.needsHistogram()) {
+        histograms.resize(capacity);
+    } else {
+        histograms.clear();
+    }
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const StepObjective& BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getObjective() const noexcept {
+    return objective;
+}
+
+// Cost bound
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::setCostBound(std::uint64_t cost_bound_arg) noexcept {
+    cost_bound = cost_bound_arg;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getCostBound() const noexcept {
+    return cost_bound;
+}
+
+// Reset verification results and counters of all loaded candidates
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::start() {
+    for (std::size_t i = 0; i < count; ++i) {
+        results[i] = CandidateResult{};
+    }
+    for (std::size_t i = 0; i < count && i < histograms.size(); ++i) {
+        histograms[i].clear();
+    }
+    valid_count = count;
+    counters = Counters{};
+}
+
+// Run all still valid candidates on input and compare with reference output
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::execute(const InputVariablesType& input, const OutputVariablesType& reference_output, bool reference_infinite_loop) {
+    const Variables<N, K, T> variables(input);
+
+    active_lanes.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!results[i].valid) {
+            continue;
+        }
+        LaneState& lane = lanes[i];
+        lane.rabbit = FullStateType(variables, 0);
+        lane.turtle = lane.rabbit;
+        lane.steps = 0;
+        lane.cost = 0;
+        // Run which reaches the bound makes the candidate invalid if no more such inputs are allowed
+        lane.limit = results[i].over_bound_inputs == allowed_over_bound ? cost_bound : std::numeric_limits<std::uint64_t>::max();
+        lane.status = ELaneStatus::Running;
+        ++counters.inputs_executed;
+        if (!runAccelerated(i, input)) {
+            active_lanes.push_back(i);
+        }
+    }
+
+    // Step all running candidates together, one RabbitTurtle iteration per round
+    while (!active_lanes.empty()) {
+        if (cost_model) {
+            stepActiveLanes<true>();
+        } else {
+            stepActiveLanes<false>();
+        }
+    }
+
+    // Compare with the reference
+    for (std::size_t i = 0; i < count; ++i) {
+        CandidateResult& result = results[i];
+        if (!result.valid) {
+            continue;
+        }
+        const LaneState& lane = lanes[i];
+        const bool stopped = lane.status == ELaneStatus::OverBound;
+        if (!stopped) {
+            const std::uint64_t value = cost_model ? lane.cost : lane.steps;
+            result.total_steps += value;
+            result.worst_steps = std::max(result.worst_steps, value);
+            if (value >= cost_bound) {
+                ++result.over_bound_inputs;
+            }
+            if (!histograms.empty()) {
+                histograms[i].add(value);
+            }
+        }
+
+        const bool infinite_loop = lane.status == ELaneStatus::InfiniteLoop;
+        const bool over_bound = objective.type == EStepObjective::Total ? result.total_steps >= cost_bound
+                                                                          : result.over_bound_inputs > allowed_over_bound;
+        if (stopped) {
+            // Rest of the run could only increase its step count or cost
+            result.reject_reason = ERejectReason::CostBound;
+        } else if (infinite_loop != reference_infinite_loop) {
+            result.reject_reason = ERejectReason::TerminationMismatch;
+        } else if (!infinite_loop && lane.rabbit.getVariables().output.values != reference_output.values) {
+            // Finished program leaves its output in rabbit state
+            result.reject_reason = ERejectReason::OutputMismatch;
+        } else if (over_bound) {
+            result.reject_reason = ERejectReason::CostBound;
+        }
+        if (result.reject_reason != ERejectReason::None) {
+            result.valid = false;
+            --valid_count;
+        }
+    }
+}
+
+// Check if at least one candidate is still valid
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::hasValidCandidates() const noexcept {
+    return valid_count > 0;
+}
+
+// Access to verification results
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename BatchExecutor<InstructionSet, N, K, T, ProgramClass>::CandidateResult& BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getResult(std::size_t candidate_index) const {
+    assert(candidate_index < count);
+    return results[candidate_index];
+}
+
+// Value of objective of candidate
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getObjectiveValue(std::size_t candidate_index) const {
+    assert(candidate_index < count);
+    const CandidateResult& result = results[candidate_index];
+    return objective.getValue(result.total_steps, result.worst_steps, histograms.empty() ? nullptr : &histograms[candidate_index]);
+}
+
+// Access to work counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename BatchExecutor<InstructionSet, N, K, T, ProgramClass>::Counters& BatchExecutor<InstructionSet, N, K, T, ProgramClass>::getCounters() const noexcept {
+    return counters;
+}
+
+// Run candidate by its accelerator
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::runAccelerated(std::size_t candidate_index, const InputVariablesType& input) {
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        if (!accelerators[candidate_index]) {
+            return false;
+        }
+        // Program which doesn't finish is stepped, so infinite loop is detected exactly as by RabbitTurtle
+        OutputVariablesType output;
+        std::uint64_t instruction_count = 0;
+        if (!accelerators[candidate_index]->run(input, output, instruction_count, 2 * max_steps + 2)) {
+            return false;
+        }
+        // RabbitTurtle counts iterations in which both rabbit steps succeeded
+        LaneState& lane = lanes[candidate_index];
+        lane.steps = (instruction_count > 0) ? (instruction_count + 1) / 2 - 1 : 0;
+        lane.rabbit.getVariables().output = output;
+        lane.status = lane.steps >= lane.limit ? ELaneStatus::OverBound : ELaneStatus::Finished;
+        ++counters.accelerated_runs;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+// Make one RabbitTurtle iteration of all active lanes
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+template<bool WEIGHTED>
+inline void BatchExecutor<InstructionSet, N, K, T, ProgramClass>::stepActiveLanes() {
+    for (std::size_t active_index = 0; active_index < active_lanes.size();) {
+        const std::size_t i = active_lanes[active_index];
+        LaneState& lane = lanes[i];
+
+        bool running;
+        if constexpr (WEIGHTED) {
+            running = step(i, lane.rabbit, lane.cost) && step(i, lane.rabbit, lane.cost) && step(i, lane.turtle);
+        } else {
+            running = step(i, lane.rabbit) && step(i, lane.rabbit) && step(i, lane.turtle);
+        }
+        if (!running) {
+            lane.status = ELaneStatus::Finished;
+        } else {
+            ++lane.steps;
+            ++counters.cycle_checks;
+            if (lane.rabbit.isSame(lane.turtle) || lane.steps > max_steps) {
+                lane.status = ELaneStatus::InfiniteLoop;
+            } else if ((WEIGHTED ? lane.cost : lane.steps) >= lane.limit) {
+                lane.status = ELaneStatus::OverBound;
+            }
+        }
+
+        if (lane.status == ELaneStatus::Running) {
+            ++active_index;
+        } else {
+            active_lanes[active_index] = active_lanes.back();
+            active_lanes.pop_back();
+        }
+    }
+}
+
+// Execute one instruction of the candidate
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::step(std::size_t candidate_index, FullStateType& state) {
+    if (state.instructionPointer() >= program_len) {
+        return false;
+    }
+    ++counters.instructions_executed;
+    instructions[state.instructionPointer() * capacity + candidate_index].execute(state);
+    return state.instructionPointer() < program_len;
+}
+
+// Execute one instruction of the candidate and add its cost
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool BatchExecutor<InstructionSet, N, K, T, ProgramClass>::step(std::size_t candidate_index, FullStateType& state, std::uint64_t& cost) {
+    const std::size_t position = state.instructionPointer();
+    if (position >= program_len) {
+        return false;
+    }
+    ++counters.instructions_executed;
+    const std::size_t slot = position * capacity + candidate_index;
+    instructions[slot].execute(state);
+    cost += state.instructionPointer() == position + 1 ? costs[slot].not_taken : costs[slot].taken;
+    return state.instructionPointer() < program_len;
+}
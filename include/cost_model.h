@@ -0,0 +1,47 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "packed_instruction.h"
+
+// Cost of executed instructions by opcode, used instead of plain step count to rank programs
+// Jumps have separate costs of taken and not taken outcome, a jump to the next position is not taken
+// Other instructions have the same cost for both outcomes
+class CostModel {
+public:
+    // Count of values of 5-bit packed opcode
+    static constexpr std::size_t OPCODE_COUNT = 32;
+
+    // Cost of one execution of instruction
+    struct Cost {
+        std::uint32_t not_taken = 1;
+        std::uint32_t taken = 1;
+    };
+
+    // Constructors
+    // Every instruction costs 1, so total cost is count of executed instructions
+    CostModel() = default;
+
+    // Approximate latencies of modern x86 cores in cycles, branch mispredictions aren't modelled
+    static CostModel makeX86();
+
+    // Set cost of instruction, it is the same for both outcomes
+    void setCost(EPackedOpcode opcode, std::uint32_t cost) noexcept;
+
+    // Set costs of jump instruction
+    void setJumpCost(EPackedOpcode opcode, std::uint32_t not_taken, std::uint32_t taken) noexcept;
+
+    // Access to costs
+    const Cost& getCost(EPackedOpcode opcode) const noexcept;
+
+    // Access to costs of instruction of any instruction set
+    template<typename InstructionType>
+    const Cost& getCost(const InstructionType& instruction) const;
+
+private:
+    std::array<Cost, OPCODE_COUNT> costs{};
+};
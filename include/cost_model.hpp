@@ -0,0 +1,64 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include "cost_model.h"
+#include "packed_instruction.hpp"
+
+// Approximate latencies of modern x86 cores
+inline CostModel CostModel::makeX86() {
+    CostModel model;
+    model.setCost(EPackedOpcode::Add, 1);
+    model.setCost(EPackedOpcode::Sub, 1);
+    model.setCost(EPackedOpcode::Inc, 1);
+    model.setCost(EPackedOpcode::Dec, 1);
+    model.setCost(EPackedOpcode::Move, 1);
+    model.setCost(EPackedOpcode::SetC, 1);
+    model.setCost(EPackedOpcode::Swap, 2);
+    model.setCost(EPackedOpcode::Mul, 3);
+    model.setCost(EPackedOpcode::Div, 12);
+
+    // Indexed access waits for L1 load, store retires through store buffer
+    model.setCost(EPackedOpcode::LoadIndirect, 5);
+    model.setCost(EPackedOpcode::StoreIndirect, 2);
+    model.setCost(EPackedOpcode::SwapIndirect, 6);
+
+    // Taken branch redirects instruction fetch
+    model.setJumpCost(EPackedOpcode::Goto, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfGreater, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfLess, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfGreaterOrEqual, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfLessOrEqual, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfEqual, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfZero, 1, 2);
+    model.setJumpCost(EPackedOpcode::JumpIfLessIndirect, 5, 6);
+    model.setJumpCost(EPackedOpcode::JumpIfGreaterIndirect, 5, 6);
+    model.setJumpCost(EPackedOpcode::JumpIfEqualIndirect, 5, 6);
+    return model;
+}
+
+// Set cost of instruction
+inline void CostModel::setCost(EPackedOpcode opcode, std::uint32_t cost) noexcept {
+    setJumpCost(opcode, cost, cost);
+}
+
+// Set costs of jump instruction
+inline void CostModel::setJumpCost(EPackedOpcode opcode, std::uint32_t not_taken, std::uint32_t taken) noexcept {
+    assert(static_cast<std::size_t>(opcode) < OPCODE_COUNT);
+    Cost& cost = costs[static_cast<std::size_t>(opcode)];
+    cost.not_taken = not_taken;
+    cost.taken = taken;
+}
+
+// Access to costs
+inline const CostModel::Cost& CostModel::getCost(EPackedOpcode opcode) const noexcept {
+    assert(static_cast<std::size_t>(opcode) < OPCODE_COUNT);
+    return costs[static_cast<std::size_t>(opcode)];
+}
+
+template<typename InstructionType>
+inline const CostModel::Cost& CostModel::getCost(const InstructionType& instruction) const {
+    return getCost(instruction.encode().getOpcode());
+}
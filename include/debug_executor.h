@@ -8,10 +8,10 @@
 #include "variables.h"
 
 // Template class for debugging program execution
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
 class DebugExecutor {
 public:
-    using ProgramType = Program<InstructionSet, N, K, T>;
+    using ProgramType = ProgramClass;
     using InputVariablesType = InputVariables<N>;
     using OutputVariablesType = OutputVariables<K>;
 
@@ -31,7 +31,7 @@ public:
     std::size_t getStepCount() const;
 
 private:
-    RabbitTurtle<InstructionSet, N, K, T> rabbit_turtle;
+    RabbitTurtle<InstructionSet, N, K, T, ProgramClass> rabbit_turtle;
     std::size_t step_count = 0;
 };
 
@@ -9,14 +9,14 @@
 #include <limits>
 
 // Constructors
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline DebugExecutor<InstructionSet, N, K, T>::DebugExecutor(const typename DebugExecutor<InstructionSet, N, K, T>::ProgramType& program_arg, const typename DebugExecutor<InstructionSet, N, K, T>::InputVariablesType& input_arg)
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline DebugExecutor<InstructionSet, N, K, T, ProgramClass>::DebugExecutor(const typename DebugExecutor<InstructionSet, N, K, T, ProgramClass>::ProgramType& program_arg, const typename DebugExecutor<InstructionSet, N, K, T, ProgramClass>::InputVariablesType& input_arg)
     : rabbit_turtle(program_arg, input_arg) {
 }
 
 // Execute program to completion or until infinite loop detected
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void DebugExecutor<InstructionSet, N, K, T>::execute() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void DebugExecutor<InstructionSet, N, K, T, ProgramClass>::execute() {
     // Start execution and dump initial state
     std::cout << rabbit_turtle.startDump() << std::endl;
     std::cout << "Press Enter to continue..." << std::flush;
@@ -51,20 +51,20 @@ inline void DebugExecutor<InstructionSet, N, K, T>::execute() {
 }
 
 // Get output variables
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename DebugExecutor<InstructionSet, N, K, T>::OutputVariablesType& DebugExecutor<InstructionSet, N, K, T>::getOutput() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename DebugExecutor<InstructionSet, N, K, T, ProgramClass>::OutputVariablesType& DebugExecutor<InstructionSet, N, K, T, ProgramClass>::getOutput() const {
     return rabbit_turtle.getOutput();
 }
 
 // Check if infinite loop was detected
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool DebugExecutor<InstructionSet, N, K, T>::isInfiniteLoopDetected() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool DebugExecutor<InstructionSet, N, K, T, ProgramClass>::isInfiniteLoopDetected() const {
     return rabbit_turtle.isInfiniteLoopDetected();
 }
 
 // Get execution step count
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline std::size_t DebugExecutor<InstructionSet, N, K, T>::getStepCount() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t DebugExecutor<InstructionSet, N, K, T, ProgramClass>::getStepCount() const {
     return step_count;
 }
 
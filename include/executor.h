@@ -8,15 +8,21 @@
 #include "variables.h"
 
 // Template class for executing programs on variables
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
 class Executor {
 public:
-    using ProgramType = Program<InstructionSet, N, K, T>;
+    using ProgramType = ProgramClass;
     using FullStateType = FullState<N, K, T>;
 
     // Constructors
     explicit Executor(const ProgramType& program_arg, const InputVariables<N>& input_arg);
 
+    // Restart execution of the same program on new input
+    void reset(const InputVariables<N>& input_arg);
+
+    // Restart execution of another program on new input
+    void reset(const ProgramType& program_arg, const InputVariables<N>& input_arg);
+
     // Access to program
     const ProgramType& getProgram() const;
 
@@ -32,7 +38,7 @@ public:
     std::string dump() const;
 
 private:
-    const ProgramType& program;
+    const ProgramType* program;
     FullStateType full_state;
 };
 
@@ -3,13 +3,20 @@
 
 #pragma once
 
-#include <sstream>
+#include <cstdint>
 #include <string>
+#include "text_format.hpp"
 
 // Constructors
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline Executor<InstructionSet, N, K, T>::Executor(const typename Executor<InstructionSet, N, K, T>::ProgramType& program_arg, const InputVariables<N>& input_arg)
-    : program(program_arg) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline Executor<InstructionSet, N, K, T, ProgramClass>::Executor(const typename Executor<InstructionSet, N, K, T, ProgramClass>::ProgramType& program_arg, const InputVariables<N>& input_arg)
+    : program(&program_arg) {
+    reset(input_arg);
+}
+
+// Restart execution of the same program on new input
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Executor<InstructionSet, N, K, T, ProgramClass>::reset(const InputVariables<N>& input_arg) {
     // Initialize variables with input variables and zero-initialized output and temp
     Variables<N, K, T> variables(input_arg);
     
@@ -17,75 +24,71 @@ inline Executor<InstructionSet, N, K, T>::Executor(const typename Executor<Instr
     full_state = FullStateType(variables, 0);
 }
 
+// Restart execution of another program on new input
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Executor<InstructionSet, N, K, T, ProgramClass>::reset(const ProgramType& program_arg, const InputVariables<N>& input_arg) {
+    program = &program_arg;
+    reset(input_arg);
+}
+
 // Access to program
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename Executor<InstructionSet, N, K, T>::ProgramType& Executor<InstructionSet, N, K, T>::getProgram() const {
-    return program;
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename Executor<InstructionSet, N, K, T, ProgramClass>::ProgramType& Executor<InstructionSet, N, K, T, ProgramClass>::getProgram() const {
+    return *program;
 }
 
 // Access to full state
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Executor<InstructionSet, N, K, T>::FullStateType& Executor<InstructionSet, N, K, T>::getFullState() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Executor<InstructionSet, N, K, T, ProgramClass>::FullStateType& Executor<InstructionSet, N, K, T, ProgramClass>::getFullState() {
     return full_state;
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename Executor<InstructionSet, N, K, T>::FullStateType& Executor<InstructionSet, N, K, T>::getFullState() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename Executor<InstructionSet, N, K, T, ProgramClass>::FullStateType& Executor<InstructionSet, N, K, T, ProgramClass>::getFullState() const {
     return full_state;
 }
 
 // Execute current instruction
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool Executor<InstructionSet, N, K, T>::execute() {
-    return program.execute(full_state);
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool Executor<InstructionSet, N, K, T, ProgramClass>::execute() {
+    return program->execute(full_state);
 }
 
 // Dump current state: variables and program with current instruction marked
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline std::string Executor<InstructionSet, N, K, T>::dump() const {
-    std::ostringstream oss;
-    
-    // Dump input variables
-    oss << "Input variables: [";
-    const auto& input = full_state.getVariables().input;
-    for (unsigned i = 0; i < N; ++i) {
-        oss << static_cast<unsigned>(input.values[i]);
-        if (i < N - 1) oss << ", ";
-    }
-    oss << "]\n";
-    
-    // Dump output variables
-    oss << "Output variables: [";
-    const auto& output = full_state.getVariables().output;
-    for (unsigned i = 0; i < K; ++i) {
-        oss << static_cast<unsigned>(output.values[i]);
-        if (i < K - 1) oss << ", ";
-    }
-    oss << "]\n";
-    
-    // Dump temp variables
-    oss << "Temp variables: [";
-    const auto& temp = full_state.getVariables().temp;
-    for (unsigned i = 0; i < T; ++i) {
-        oss << static_cast<unsigned>(temp.values[i]);
-        if (i < T - 1) oss << ", ";
-    }
-    oss << "]\n";
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::string Executor<InstructionSet, N, K, T, ProgramClass>::dump() const {
+    std::string result;
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE + 1];
+
+    // Dump variables as comma-separated lists
+    const auto appendValues = [&result, &buffer](const char* title, const std::uint8_t* values, unsigned count) {
+        result += title;
+        result += '[';
+        for (unsigned i = 0; i < count; ++i) {
+            result.append(buffer, appendNumber(buffer, values[i]));
+            if (i < count - 1) result += ", ";
+        }
+        result += "]\n";
+    };
+    const auto& variables = full_state.getVariables();
+    appendValues("Input variables: ", variables.input.values.data(), N);
+    appendValues("Output variables: ", variables.output.values.data(), K);
+    appendValues("Temp variables: ", variables.temp.values.data(), T);
     
     // Dump instruction pointer
-    oss << "Instruction pointer: " << full_state.getInstructionPointer() << "\n\n";
+    result += "Instruction pointer: ";
+    result.append(buffer, appendNumber(buffer, full_state.getInstructionPointer()));
+    result += "\n\n";
     
     // Dump program with current instruction marked
-    oss << "Program:\n";
+    result += "Program:\n";
     const std::size_t current_ip = full_state.getInstructionPointer();
-    for (std::size_t i = 0; i < program.size(); ++i) {
-        if (i == current_ip) {
-            oss << "=> ";
-        } else {
-            oss << "   ";
-        }
-        oss << program[i].dump(i) << "\n";
+    for (std::size_t i = 0; i < program->size(); ++i) {
+        result += i == current_ip ? "=> " : "   ";
+        char* end = (*program)[i].appendTo(buffer, static_cast<unsigned>(i));
+        *end++ = '\n';
+        result.append(buffer, end);
     }
     
-    return oss.str();
+    return result;
 }
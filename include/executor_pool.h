@@ -0,0 +1,70 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "program.h"
+#include "rabbit_turtle.h"
+#include "variables.h"
+
+// Reusable execution context: executors are rebound to program and input by reset() instead of being constructed again
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+struct ExecutorContext {
+    using ProgramType = ProgramClass;
+    using InputVariablesType = InputVariables<N>;
+    using RabbitTurtleType = RabbitTurtle<InstructionSet, N, K, T, ProgramClass>;
+
+    // Constructors
+    explicit ExecutorContext(const ProgramType& program_arg);
+
+    RabbitTurtleType rabbit_turtle;
+};
+
+// Template class for pool of reusable execution contexts
+// Each thread has its own pool, so contexts are acquired and released without locking
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class ExecutorPool {
+public:
+    using ProgramType = ProgramClass;
+    using ContextType = ExecutorContext<InstructionSet, N, K, T, ProgramClass>;
+
+    // Context borrowed from pool, it goes back to pool on destruction
+    // Lease must be destroyed on the thread which acquired it
+    class Lease {
+    public:
+        Lease(ExecutorPool& pool_arg, std::unique_ptr<ContextType> context_arg);
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        // Access to context
+        ContextType& operator*() const noexcept;
+        ContextType* operator->() const noexcept;
+
+    private:
+        ExecutorPool* pool;
+        std::unique_ptr<ContextType> context;
+    };
+
+    // Access to pool of the calling thread
+    static ExecutorPool& getThreadPool();
+
+    // Borrow context, a new one bound to program is created only if the pool is empty
+    Lease acquire(const ProgramType& program);
+
+    // Count of contexts created by pool and count of contexts waiting in pool
+    std::size_t getCreatedCount() const noexcept;
+    std::size_t getFreeCount() const noexcept;
+
+private:
+    std::vector<std::unique_ptr<ContextType>> free_contexts;
+    std::size_t created_count = 0;
+
+    // Return context to pool
+    void release(std::unique_ptr<ContextType> context);
+};
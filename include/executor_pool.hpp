@@ -0,0 +1,76 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <utility>
+#include "executor_pool.h"
+#include "rabbit_turtle.hpp"
+
+// ExecutorContext constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ExecutorContext<InstructionSet, N, K, T, ProgramClass>::ExecutorContext(const ProgramType& program_arg)
+    : rabbit_turtle(program_arg, InputVariablesType{}) {
+}
+
+// Lease constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ExecutorPool<InstructionSet, N, K, T, ProgramClass>::Lease::Lease(ExecutorPool& pool_arg, std::unique_ptr<ContextType> context_arg)
+    : pool(&pool_arg), context(std::move(context_arg)) {
+}
+
+// Lease destructor, moved-from lease owns nothing
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ExecutorPool<InstructionSet, N, K, T, ProgramClass>::Lease::~Lease() {
+    if (context) {
+        pool->release(std::move(context));
+    }
+}
+
+// Access to leased context
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename ExecutorPool<InstructionSet, N, K, T, ProgramClass>::ContextType& ExecutorPool<InstructionSet, N, K, T, ProgramClass>::Lease::operator*() const noexcept {
+    return *context;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename ExecutorPool<InstructionSet, N, K, T, ProgramClass>::ContextType* ExecutorPool<InstructionSet, N, K, T, ProgramClass>::Lease::operator->() const noexcept {
+    return context.get();
+}
+
+// Access to pool of the calling thread
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ExecutorPool<InstructionSet, N, K, T, ProgramClass>& ExecutorPool<InstructionSet, N, K, T, ProgramClass>::getThreadPool() {
+    static thread_local ExecutorPool pool;
+    return pool;
+}
+
+// Borrow context
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename ExecutorPool<InstructionSet, N, K, T, ProgramClass>::Lease ExecutorPool<InstructionSet, N, K, T, ProgramClass>::acquire(const ProgramType& program) {
+    if (free_contexts.empty()) {
+        ++created_count;
+        return Lease(*this, std::make_unique<ContextType>(program));
+    }
+    std::unique_ptr<ContextType> context = std::move(free_contexts.back());
+    free_contexts.pop_back();
+    return Lease(*this, std::move(context));
+}
+
+// Count of contexts created by pool
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t ExecutorPool<InstructionSet, N, K, T, ProgramClass>::getCreatedCount() const noexcept {
+    return created_count;
+}
+
+// Count of contexts waiting in pool
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t ExecutorPool<InstructionSet, N, K, T, ProgramClass>::getFreeCount() const noexcept {
+    return free_contexts.size();
+}
+
+// Return context to pool
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ExecutorPool<InstructionSet, N, K, T, ProgramClass>::release(std::unique_ptr<ContextType> context) {
+    free_contexts.push_back(std::move(context));
+}
@@ -3,16 +3,17 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 #include "program.h"
 
 // Template class Fabric for program generation/manipulation
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
 class Fabric {
 public:
-    using ProgramType = Program<InstructionSet, N, K, T>;
+    using ProgramType = ProgramClass;
     using InstructionSetType = InstructionSet<N, K, T>;
 
     // Constructors
@@ -24,11 +25,29 @@ public:
     // Generate program from current combination_indices state
     ProgramType generate() const;
 
+    // Access to live program for current combination_indices state
+    // It is updated in place by next(), only positions whose combination index changed are rewritten
+    const ProgramType& getProgram() const noexcept;
+
     // Move to next combination, returns false if no more combinations
     bool next();
 
     // Get string representation of current combination
-    const std::string& getCombinationStrId() const noexcept;
+    // It is formatted lazily on the first call after next()
+    const std::string& getCombinationStrId() const;
+    
+    // Get binary representation of current combination
+    const std::vector<std::uint64_t>& getCombinationIndices() const noexcept;
+    
+    // Get rank of current combination: count of next() calls since the first combination
+    std::uint64_t getRank() const noexcept;
+    
+    // Get count of combinations for each program position, size of the whole space is its power of program length
+    std::uint64_t getCombinationCount() const noexcept;
+    
+    // Move to the given combination, each index must be less than getCombinationCount()
+    // Rank saturates at max value if the combination is beyond 64-bit ranks
+    void seek(const std::vector<std::uint64_t>& combination_indices_arg);
     
     // Get string representation of the last possible combination
     const std::string& getLastProgramStrId() const noexcept;
@@ -37,15 +56,31 @@ private:
     // Combination indices for each program position
     std::vector<std::uint64_t> combination_indices;
     
-    // String representation of current combination
-    std::string combination_id;
+    // Count of combinations for each program position
+    std::uint64_t max_combinations;
+    
+    // Live program for current combination_indices state
+    ProgramType program;
+    
+    // Rank of current combination
+    std::uint64_t rank = 0;
+    
+    // String representation of current combination, valid only if combination_id_valid is set
+    mutable std::string combination_id;
+    mutable bool combination_id_valid = false;
     
     // String representation of the last possible combination
     std::string last_program_str_id;
     
+    // Rewrite live program instruction at position from combination_indices
+    void updateInstruction(std::size_t pos);
+    
     // Update combination_id from combination_indices
-    void updateCombinationId();
+    void updateCombinationId() const;
     
     // Initialize last_program_str_id
     void initializeLastProgramStrId();
+
+    // Append text representation of combination indices, e.g. "[0x1, 0x1f]"
+    static void appendCombinationId(const std::uint64_t* indices, std::size_t count, std::string& output);
 };
@@ -2,48 +2,55 @@
 // License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
 
 #include "fabric.h"
-#include <sstream>
+#include <cassert>
+#include <limits>
 #include <string>
+#include "text_format.hpp"
 
 // Constructors
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline Fabric<InstructionSet, N, K, T>::Fabric(unsigned programLen)
-    : combination_indices(programLen, 0) {
-    updateCombinationId();
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline Fabric<InstructionSet, N, K, T, ProgramClass>::Fabric(unsigned programLen)
+    : combination_indices(programLen, 0), max_combinations(InstructionSetType::getCombinationCount(programLen)), program(programLen) {
+    for (std::size_t pos = 0; pos < combination_indices.size(); ++pos) {
+        program.add(InstructionSetType::getCombination(combination_indices[pos], programLen));
+    }
     initializeLastProgramStrId();
 }
 
 // Access to program length
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline unsigned Fabric<InstructionSet, N, K, T>::getProgramLen() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline unsigned Fabric<InstructionSet, N, K, T, ProgramClass>::getProgramLen() const noexcept {
     return static_cast<unsigned>(combination_indices.size());
 }
 
 // Generate program from current combination_indices state
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Fabric<InstructionSet, N, K, T>::ProgramType Fabric<InstructionSet, N, K, T>::generate() const {
-    ProgramType program;
-    
-    // For each position in the program
-    for (std::uint64_t combination_index : combination_indices) {
-        // Use InstructionSet::getCombination to generate the instruction
-        InstructionSetType instruction = InstructionSetType::getCombination(combination_index, getProgramLen());
-        
-        // Add the instruction to the program
-        program.add(instruction);
-    }
-    
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Fabric<InstructionSet, N, K, T, ProgramClass>::ProgramType Fabric<InstructionSet, N, K, T, ProgramClass>::generate() const {
+    // Live program always reflects combination_indices, so generated program is its copy
     return program;
 }
 
+// Access to live program for current combination_indices state
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename Fabric<InstructionSet, N, K, T, ProgramClass>::ProgramType& Fabric<InstructionSet, N, K, T, ProgramClass>::getProgram() const noexcept {
+    return program;
+}
+
+// Rewrite live program instruction at position from combination_indices
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Fabric<InstructionSet, N, K, T, ProgramClass>::updateInstruction(std::size_t pos) {
+    program[pos] = InstructionSetType::getCombination(combination_indices[pos], getProgramLen());
+}
+
 // Move to next combination
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool Fabric<InstructionSet, N, K, T>::next() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool Fabric<InstructionSet, N, K, T, ProgramClass>::next() {
     if (combination_indices.empty()) {
         return false;
     }
     
-    const std::uint64_t max_combinations = InstructionSetType::getCombinationCount(getProgramLen());
+    // String representation is formatted on demand
+    combination_id_valid = false;
     
     // Increment combination indices like a number in base max_combinations
     // Start from the last position
@@ -53,66 +60,111 @@ inline bool Fabric<InstructionSet, N, K, T>::next() {
         
         // If this position hasn't overflowed, we're done
         if (combination_indices[pos] < max_combinations) {
-            updateCombinationId();
+            updateInstruction(pos);
+            ++rank;
             return true;
         }
         
         // Otherwise, reset this position to 0 and carry over to the next position
         combination_indices[pos] = 0;
+        updateInstruction(pos);
     }
     
     // All positions have overflowed, no more combinations
-    updateCombinationId();
+    rank = 0;
     return false;
 }
 
 // Get string representation of current combination
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const std::string& Fabric<InstructionSet, N, K, T>::getCombinationStrId() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const std::string& Fabric<InstructionSet, N, K, T, ProgramClass>::getCombinationStrId() const {
+    if (!combination_id_valid) {
+        updateCombinationId();
+    }
     return combination_id;
 }
 
-// Update combination_id from combination_indices
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void Fabric<InstructionSet, N, K, T>::updateCombinationId() {
-    std::ostringstream oss;
-    oss << "[";
-    for (std::size_t i = 0; i < combination_indices.size(); ++i) {
-        oss << "0x" << std::hex << combination_indices[i];
-        if (i < combination_indices.size() - 1) {
-            oss << ", ";
+// Get binary representation of current combination
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const std::vector<std::uint64_t>& Fabric<InstructionSet, N, K, T, ProgramClass>::getCombinationIndices() const noexcept {
+    return combination_indices;
+}
+
+// Get rank of current combination
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Fabric<InstructionSet, N, K, T, ProgramClass>::getRank() const noexcept {
+    return rank;
+}
+
+// Get count of combinations for each program position
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Fabric<InstructionSet, N, K, T, ProgramClass>::getCombinationCount() const noexcept {
+    return max_combinations;
+}
+
+// Move to the given combination
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Fabric<InstructionSet, N, K, T, ProgramClass>::seek(const std::vector<std::uint64_t>& combination_indices_arg) {
+    assert(combination_indices_arg.size() == combination_indices.size());
+    combination_id_valid = false;
+    
+    // The first position is the most significant digit, see next()
+    rank = 0;
+    for (std::size_t pos = 0; pos < combination_indices.size(); ++pos) {
+        assert(combination_indices_arg[pos] < max_combinations);
+        if (combination_indices[pos] != combination_indices_arg[pos]) {
+            combination_indices[pos] = combination_indices_arg[pos];
+            updateInstruction(pos);
+        }
+        if (rank > (std::numeric_limits<std::uint64_t>::max() - combination_indices[pos]) / max_combinations) {
+            rank = std::numeric_limits<std::uint64_t>::max();
+        } else if (rank != std::numeric_limits<std::uint64_t>::max()) {
+            rank = rank * max_combinations + combination_indices[pos];
         }
     }
-    oss << "]";
-    combination_id = oss.str();
+}
+
+// Update combination_id from combination_indices
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Fabric<InstructionSet, N, K, T, ProgramClass>::updateCombinationId() const {
+    // String keeps its capacity, so repeated updates don't allocate
+    combination_id.clear();
+    appendCombinationId(combination_indices.data(), combination_indices.size(), combination_id);
+    combination_id_valid = true;
 }
 
 // Get string representation of the last possible combination
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const std::string& Fabric<InstructionSet, N, K, T>::getLastProgramStrId() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const std::string& Fabric<InstructionSet, N, K, T, ProgramClass>::getLastProgramStrId() const noexcept {
     return last_program_str_id;
 }
 
 // Initialize last_program_str_id
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void Fabric<InstructionSet, N, K, T>::initializeLastProgramStrId() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Fabric<InstructionSet, N, K, T, ProgramClass>::initializeLastProgramStrId() {
     if (combination_indices.empty()) {
         last_program_str_id = "[]";
         return;
     }
     
-    const std::uint64_t max_combinations = InstructionSetType::getCombinationCount(getProgramLen());
     const std::uint64_t last_index = (max_combinations > 0) ? max_combinations - 1 : 0;
-    
-    std::ostringstream oss;
-    oss << "[";
-    for (std::size_t i = 0; i < combination_indices.size(); ++i) {
-        oss << "0x" << std::hex << last_index;
-        if (i < combination_indices.size() - 1) {
-            oss << ", ";
+    const std::vector<std::uint64_t> last_indices(combination_indices.size(), last_index);
+    last_program_str_id.clear();
+    appendCombinationId(last_indices.data(), last_indices.size(), last_program_str_id);
+}
+
+// Append text representation of combination indices
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Fabric<InstructionSet, N, K, T, ProgramClass>::appendCombinationId(const std::uint64_t* indices, std::size_t count, std::string& output) {
+    char buffer[MAX_NUMBER_TEXT_SIZE];
+    output += '[';
+    for (std::size_t i = 0; i < count; ++i) {
+        output += "0x";
+        output.append(buffer, appendHexNumber(buffer, indices[i]));
+        if (i < count - 1) {
+            output += ", ";
         }
     }
-    oss << "]";
-    last_program_str_id = oss.str();
+    output += ']';
 }
 
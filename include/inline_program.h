@@ -0,0 +1,73 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include "full_state.h"
+#include "text_format.h"
+
+// Template class for program with compile-time maximum length
+// It has the same interface as Program, but instructions are stored inline in std::array,
+// so creating, copying and growing the program never allocates memory
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+class InlineProgram {
+public:
+    using InstructionSetType = InstructionSet<N, K, T>;
+    using Instructions = std::array<InstructionSetType, MaxLength>;
+    using size_type = typename Instructions::size_type;
+    using iterator = typename Instructions::iterator;
+    using const_iterator = typename Instructions::const_iterator;
+
+    static constexpr unsigned MAX_LENGTH = MaxLength;
+
+    // Constructors
+    InlineProgram() = default;
+    explicit InlineProgram(size_type capacity);
+
+    // Add instruction
+    template<typename Instruction>
+    void add(Instruction&& inst);
+
+    // Access to instructions
+    InstructionSetType& operator[](size_type index);
+    const InstructionSetType& operator[](size_type index) const;
+
+    // Program size
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    // Iterators
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // Clear
+    void clear() noexcept;
+
+    // Reserve memory, capacity must not exceed MaxLength
+    void reserve(size_type capacity);
+
+    // Swap
+    void swap(InlineProgram& other) noexcept;
+
+    // Execute current instruction
+    // Returns false if program is finished (instruction_pointer >= size), true otherwise
+    bool execute(FullState<N, K, T>& full_state) const;
+
+    // Dump program as text representation
+    std::string dump() const;
+
+    // Append text representation to output, memory is allocated only if output has to grow
+    void appendTo(std::string& output) const;
+
+private:
+    Instructions instructions;
+    size_type instruction_count = 0;
+};
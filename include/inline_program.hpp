@@ -0,0 +1,130 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include "inline_program.h"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline InlineProgram<InstructionSet, N, K, T, MaxLength>::InlineProgram(size_type capacity) {
+    reserve(capacity);
+}
+
+// Add instruction
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+template<typename Instruction>
+inline void InlineProgram<InstructionSet, N, K, T, MaxLength>::add(Instruction&& inst) {
+    assert(instruction_count < MaxLength);
+    instructions[instruction_count++] = std::forward<Instruction>(inst);
+}
+
+// Access to instructions
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::InstructionSetType& InlineProgram<InstructionSet, N, K, T, MaxLength>::operator[](size_type index) {
+    assert(index < instruction_count);
+    return instructions[index];
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline const typename InlineProgram<InstructionSet, N, K, T, MaxLength>::InstructionSetType& InlineProgram<InstructionSet, N, K, T, MaxLength>::operator[](size_type index) const {
+    assert(index < instruction_count);
+    return instructions[index];
+}
+
+// Program size
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::size_type InlineProgram<InstructionSet, N, K, T, MaxLength>::size() const noexcept {
+    return instruction_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline bool InlineProgram<InstructionSet, N, K, T, MaxLength>::empty() const noexcept {
+    return instruction_count == 0;
+}
+
+// Iterators
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::begin() noexcept {
+    return instructions.begin();
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::end() noexcept {
+    return instructions.begin() + instruction_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::const_iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::begin() const noexcept {
+    return instructions.begin();
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::const_iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::end() const noexcept {
+    return instructions.begin() + instruction_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::const_iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::cbegin() const noexcept {
+    return instructions.cbegin();
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline typename InlineProgram<InstructionSet, N, K, T, MaxLength>::const_iterator InlineProgram<InstructionSet, N, K, T, MaxLength>::cend() const noexcept {
+    return instructions.cbegin() + instruction_count;
+}
+
+// Clear
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline void InlineProgram<InstructionSet, N, K, T, MaxLength>::clear() noexcept {
+    instruction_count = 0;
+}
+
+// Reserve memory, storage is inline so only the bound is checked
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline void InlineProgram<InstructionSet, N, K, T, MaxLength>::reserve(size_type capacity) {
+    assert(capacity <= MaxLength);
+    static_cast<void>(capacity);
+}
+
+// Swap
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline void InlineProgram<InstructionSet, N, K, T, MaxLength>::swap(InlineProgram& other) noexcept {
+    instructions.swap(other.instructions);
+    std::swap(instruction_count, other.instruction_count);
+}
+
+// Execute current instruction
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline bool InlineProgram<InstructionSet, N, K, T, MaxLength>::execute(FullState<N, K, T>& full_state) const {
+    if (full_state.instructionPointer() >= instruction_count) {
+        return false;
+    }
+    
+    const auto& instruction = instructions[full_state.instructionPointer()];
+    const_cast<InstructionSetType&>(instruction).execute(full_state);
+    
+    // Check instruction pointer after execution, as instruction may have modified it
+    return full_state.instructionPointer() < instruction_count;
+}
+
+// Dump program as text representation
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline std::string InlineProgram<InstructionSet, N, K, T, MaxLength>::dump() const {
+    std::string result;
+    appendTo(result);
+    return result;
+}
+
+// Append text representation
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, unsigned MaxLength>
+inline void InlineProgram<InstructionSet, N, K, T, MaxLength>::appendTo(std::string& output) const {
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE + 1];
+    for (size_type i = 0; i < instruction_count; ++i) {
+        char* end = instructions[i].appendTo(buffer, static_cast<unsigned>(i));
+        *end++ = '\n';
+        output.append(buffer, end);
+    }
+}
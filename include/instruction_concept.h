@@ -5,6 +5,7 @@
 
 #include <concepts>
 #include "full_state.h"
+#include "loop_role.h"
 
 // Concept for instruction classes
 // Instruction must have a method that takes FullState by non-const reference
@@ -14,4 +15,9 @@ concept InstructionConcept = requires(Instruction instruction, FullState<N, K, T
     { instruction.execute(state) } -> std::same_as<void>;
 };
 
-
+// Concept for instruction sets which describe their role in counting loops
+// Used by LoopAccelerator, instruction sets without getLoopRole() are simply not accelerated
+template<typename Instruction, unsigned N, unsigned K, unsigned T>
+concept LoopRoleConcept = requires(const Instruction& instruction) {
+    { instruction.getLoopRole() } -> std::same_as<LoopRole<N, K, T>>;
+};
@@ -0,0 +1,9 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <string>
+
+// Escape string for JSON, control characters without short escape are written as \u00XX
+std::string escapeJson(const std::string& text);
@@ -0,0 +1,36 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include "json_escape.h"
+
+// Escape string for JSON
+inline std::string escapeJson(const std::string& text) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(text.size());
+    for (const char symbol : text) {
+        switch (symbol) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default: {
+                const unsigned char code = static_cast<unsigned char>(symbol);
+                if (code < 0x20) {
+                    result += "\\u00";
+                    result += HEX_DIGITS[code >> 4];
+                    result += HEX_DIGITS[code & 0xf];
+                } else {
+                    result += symbol;
+                }
+                break;
+            }
+        }
+    }
+    return result;
+}
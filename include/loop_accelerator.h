@@ -0,0 +1,103 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+#include "address.h"
+#include "full_state.h"
+#include "instruction_concept.h"
+#include "loop_role.h"
+#include "program.h"
+#include "variables.h"
+
+// Template class which executes programs with closed-form evaluation of affine counting loops
+// Counting loop is a region [head, tail] where:
+// * tail is "Goto head"
+// * exactly one instruction in [head, tail) is JumpIfZero or JumpIfEqual leaving the region
+// * all other instructions are Inc or Dec
+// Exit iteration, final variable values and executed instruction count are computed arithmetically over uint8
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class LoopAccelerator {
+public:
+    using ProgramType = ProgramClass;
+    using InstructionSetType = InstructionSet<N, K, T>;
+    using InputVariablesType = InputVariables<N>;
+    using OutputVariablesType = OutputVariables<K>;
+    using FullStateType = FullState<N, K, T>;
+    using AddressType = Address<N, K, T>;
+    using LoopRoleType = LoopRole<N, K, T>;
+
+    // Constructors
+    // Analysis results are allocated from resource, e.g. from per-batch Arena
+    explicit LoopAccelerator(const ProgramType& program_arg,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Access to program
+    const ProgramType& getProgram() const;
+
+    // Check if at least one counting loop was recognised
+    bool isAccelerated() const noexcept;
+
+    // Count of recognised counting loops
+    std::size_t getLoopCount() const noexcept;
+
+    // Fast-forward state through the counting loop which starts at the current instruction pointer
+    // Adds count of skipped instructions to instruction_count
+    // Returns false (state is untouched) if no loop starts here or the loop never exits for this state
+    bool skipLoop(FullStateType& state, std::uint64_t& instruction_count) const;
+
+    // Execute program to completion, fast-forwarding all recognised counting loops
+    // instruction_count receives count of executed instructions, exactly as if they were stepped one by one
+    // Returns false if program did not finish within max_instruction_count or was found to loop forever
+    bool run(const InputVariablesType& input, OutputVariablesType& output, std::uint64_t& instruction_count,
+             std::uint64_t max_instruction_count = std::numeric_limits<std::uint64_t>::max()) const;
+
+private:
+    static constexpr std::size_t NO_LOOP = std::numeric_limits<std::size_t>::max();
+
+    // Accumulated change of one variable: value after the test of iteration k is value + pre_delta + total_delta * k
+    struct StepDelta {
+        AddressType address;
+        std::uint8_t pre_delta = 0;
+        std::uint8_t total_delta = 0;
+    };
+
+    struct CountingLoop {
+        std::size_t head = 0;
+        std::size_t length = 0;            // Instruction count of one iteration, including Goto
+        std::size_t instructions_to_exit = 0; // Instructions executed in the last iteration, including the test
+        std::size_t exit_target = 0;
+        typename LoopRoleType::EKind test_kind = LoopRoleType::EKind::JumpIfZero;
+        StepDelta operand1;
+        StepDelta operand2;
+        std::size_t first_step = 0;        // Stepped variables of the loop are steps[first_step, first_step + step_count)
+        std::size_t step_count = 0;
+    };
+
+    const ProgramType& program;
+    std::pmr::vector<CountingLoop> loops;
+    std::pmr::vector<std::size_t> loop_index_by_head;
+    std::pmr::vector<StepDelta> steps;
+
+    // Find counting loop which starts at position, returns nullptr if there is no such loop
+    const CountingLoop* findLoop(std::size_t position) const;
+
+    // Fast-forward state through the given loop, returns false if the loop never exits for this state
+    bool skipLoop(const CountingLoop& loop, FullStateType& state, std::uint64_t& instruction_count) const;
+
+    // Try to recognise counting loop [head, tail], its stepped variables are appended to steps
+    bool recogniseLoop(std::size_t head, std::size_t tail, CountingLoop& loop);
+
+    // Scan instructions of counting loop [head, tail], returns false if it isn't a counting loop
+    bool recogniseLoopBody(std::size_t head, std::size_t tail, CountingLoop& loop);
+
+    // Find smallest k >= 0 such that (constant + factor * k) mod 256 == 0
+    static bool solveIterationCount(std::uint8_t constant, std::uint8_t factor, std::uint64_t& iteration_count);
+
+    static bool isSameAddress(const AddressType& address1, const AddressType& address2);
+};
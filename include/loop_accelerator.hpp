@@ -0,0 +1,252 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstdint>
+#include "loop_accelerator.h"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::LoopAccelerator(const ProgramType& program_arg, std::pmr::memory_resource* resource)
+    : program(program_arg), loops(resource), loop_index_by_head(resource), steps(resource) {
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        // Each backward Goto is a candidate for the tail of a counting loop
+        for (std::size_t tail = 0; tail < program.size(); ++tail) {
+            const LoopRoleType role = program[tail].getLoopRole();
+            if (role.kind != LoopRoleType::EKind::Goto || role.target >= tail) {
+                continue;
+            }
+            const std::size_t head = role.target;
+            if (!loop_index_by_head.empty() && loop_index_by_head[head] != NO_LOOP) {
+                continue;
+            }
+
+            CountingLoop loop;
+            if (!recogniseLoop(head, tail, loop)) {
+                continue;
+            }
+
+            if (loop_index_by_head.empty()) {
+                loop_index_by_head.resize(program.size(), NO_LOOP);
+            }
+            loop_index_by_head[head] = loops.size();
+            loops.push_back(std::move(loop));
+        }
+    }
+}
+
+// Access to program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::ProgramType& LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::getProgram() const {
+    return program;
+}
+
+// Check if at least one counting loop was recognised
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::isAccelerated() const noexcept {
+    return !loops.empty();
+}
+
+// Count of recognised counting loops
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::getLoopCount() const noexcept {
+    return loops.size();
+}
+
+// Fast-forward state through the counting loop which starts at the current instruction pointer
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::skipLoop(FullStateType& state, std::uint64_t& instruction_count) const {
+    const CountingLoop* loop = findLoop(state.getInstructionPointer());
+    return loop && skipLoop(*loop, state, instruction_count);
+}
+
+// Execute program to completion, fast-forwarding all recognised counting loops
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::run(const InputVariablesType& input, OutputVariablesType& output,
+                                                          std::uint64_t& instruction_count, std::uint64_t max_instruction_count) const {
+    FullStateType state(Variables<N, K, T>(input), 0);
+    instruction_count = 0;
+
+    // Brent's cycle detection over the sequence of states, skipped loops are deterministic transitions too
+    FullStateType saved_state = state;
+    std::uint64_t power = 1;
+    std::uint64_t cycle_length = 0;
+
+    while (state.getInstructionPointer() < program.size()) {
+        const CountingLoop* loop = findLoop(state.getInstructionPointer());
+        if (loop) {
+            if (!skipLoop(*loop, state, instruction_count)) {
+                return false; // Loop never exits
+            }
+        } else {
+            program.execute(state);
+            ++instruction_count;
+        }
+        if (instruction_count > max_instruction_count) {
+            return false;
+        }
+
+        if (state.isSame(saved_state)) {
+            return false; // Infinite loop
+        }
+        if (++cycle_length == power) {
+            saved_state = state;
+            power *= 2;
+            cycle_length = 0;
+        }
+    }
+
+    output = state.getVariables().output;
+    return true;
+}
+
+// Find counting loop which starts at position
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::CountingLoop* LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::findLoop(std::size_t position) const {
+    if (position >= loop_index_by_head.size() || loop_index_by_head[position] == NO_LOOP) {
+        return nullptr;
+    }
+    return &loops[loop_index_by_head[position]];
+}
+
+// Fast-forward state through the given loop
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::skipLoop(const CountingLoop& loop, FullStateType& state, std::uint64_t& instruction_count) const {
+    // Value tested in iteration k is (constant + factor * k) mod 256
+    std::uint8_t constant = static_cast<std::uint8_t>(loop.operand1.address.getValue(state) + loop.operand1.pre_delta);
+    std::uint8_t factor = loop.operand1.total_delta;
+    if (loop.test_kind == LoopRoleType::EKind::JumpIfEqual) {
+        constant -= static_cast<std::uint8_t>(loop.operand2.address.getValue(state) + loop.operand2.pre_delta);
+        factor -= loop.operand2.total_delta;
+    }
+
+    std::uint64_t iteration_count = 0;
+    if (!solveIterationCount(constant, factor, iteration_count)) {
+        return false;
+    }
+
+    for (std::size_t i = loop.first_step; i < loop.first_step + loop.step_count; ++i) {
+        const StepDelta& step = steps[i];
+        const std::uint64_t delta = step.pre_delta + step.total_delta * iteration_count;
+        step.address.setValue(state, static_cast<std::uint8_t>(step.address.getValue(state) + delta));
+    }
+    state.instructionPointer() = loop.exit_target;
+    instruction_count += iteration_count * loop.length + loop.instructions_to_exit;
+    return true;
+}
+
+// Try to recognise counting loop [head, tail]
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::recogniseLoop(std::size_t head, std::size_t tail, CountingLoop& loop) {
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        loop.first_step = steps.size();
+        if (!recogniseLoopBody(head, tail, loop)) {
+            steps.resize(loop.first_step);
+            return false;
+        }
+        loop.step_count = steps.size() - loop.first_step;
+
+        // Operands of the test see the same deltas as the stepped variables
+        for (std::size_t i = loop.first_step; i < steps.size(); ++i) {
+            const StepDelta& step = steps[i];
+            if (isSameAddress(step.address, loop.operand1.address)) {
+                loop.operand1 = step;
+            }
+            if (loop.test_kind == LoopRoleType::EKind::JumpIfEqual && isSameAddress(step.address, loop.operand2.address)) {
+                loop.operand2 = step;
+            }
+        }
+
+        loop.head = head;
+        loop.length = tail - head + 1;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+// Scan instructions of counting loop [head, tail]
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::recogniseLoopBody(std::size_t head, std::size_t tail, CountingLoop& loop) {
+    if constexpr (LoopRoleConcept<InstructionSetType, N, K, T>) {
+        bool test_found = false;
+        for (std::size_t position = head; position < tail; ++position) {
+            const LoopRoleType role = program[position].getLoopRole();
+            switch (role.kind) {
+                case LoopRoleType::EKind::Step: {
+                    const std::uint8_t delta = static_cast<std::uint8_t>(role.delta);
+                    StepDelta* existing = nullptr;
+                    for (std::size_t i = loop.first_step; i < steps.size(); ++i) {
+                        if (isSameAddress(steps[i].address, role.operand1)) {
+                            existing = &steps[i];
+                            break;
+                        }
+                    }
+                    if (!existing) {
+                        steps.push_back(StepDelta{role.operand1, 0, 0});
+                        existing = &steps.back();
+                    }
+                    if (!test_found) {
+                        existing->pre_delta += delta;
+                    }
+                    existing->total_delta += delta;
+                    break;
+                }
+                case LoopRoleType::EKind::JumpIfZero:
+                case LoopRoleType::EKind::JumpIfEqual:
+                    // Exactly one test is allowed and it must leave the loop
+                    if (test_found || (role.target >= head && role.target <= tail)) {
+                        return false;
+                    }
+                    test_found = true;
+                    loop.test_kind = role.kind;
+                    loop.operand1.address = role.operand1;
+                    loop.operand2.address = role.operand2;
+                    loop.exit_target = role.target;
+                    loop.instructions_to_exit = position - head + 1;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return test_found;
+    } else {
+        return false;
+    }
+}
+
+// Find smallest k >= 0 such that (constant + factor * k) mod 256 == 0
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::solveIterationCount(std::uint8_t constant, std::uint8_t factor, std::uint64_t& iteration_count) {
+    if (constant == 0) {
+        iteration_count = 0;
+        return true;
+    }
+    if (factor == 0) {
+        return false;
+    }
+
+    // factor = odd * divisor, where divisor is a power of two
+    const unsigned divisor = factor & (~static_cast<unsigned>(factor) + 1);
+    if (constant % divisor != 0) {
+        return false;
+    }
+    const unsigned modulus = 256 / divisor;
+    const unsigned odd = factor / divisor;
+
+    // Inverse of odd number modulo 256 by Newton iterations, each one doubles count of correct bits
+    unsigned inverse = odd;
+    for (int i = 0; i < 3; ++i) {
+        inverse = (inverse * (2 - odd * inverse)) & 0xFF;
+    }
+
+    const unsigned negated = (256 - constant) / divisor;
+    iteration_count = (negated * inverse) % modulus;
+    return true;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool LoopAccelerator<InstructionSet, N, K, T, ProgramClass>::isSameAddress(const AddressType& address1, const AddressType& address2) {
+    return address1.address_type == address2.address_type && address1.address == address2.address;
+}
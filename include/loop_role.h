@@ -0,0 +1,26 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include "address.h"
+
+// Role of an instruction inside an affine counting loop
+// Instruction sets which provide getLoopRole() allow LoopAccelerator to recognise such loops
+template<unsigned N, unsigned K, unsigned T>
+struct LoopRole {
+    enum class EKind {
+        Other,       // Any instruction which can't be a part of a counting loop
+        Step,        // operand1 += delta
+        Goto,        // Unconditional jump to target
+        JumpIfZero,  // Jump to target if operand1 == 0
+        JumpIfEqual  // Jump to target if operand1 == operand2
+    };
+
+    EKind kind = EKind::Other;
+    Address<N, K, T> operand1{};
+    Address<N, K, T> operand2{};
+    int delta = 0;
+    std::size_t target = 0;
+};
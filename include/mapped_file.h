@@ -0,0 +1,42 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of the whole file
+// Pages are loaded on demand by the operating system, so large files can be scanned without reading them into memory
+class MappedFile {
+public:
+    // Constructors
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map file, returns false and sets error if file can't be mapped
+    bool open(const std::string& file_name, std::string& error);
+
+    // Unmap file
+    void close() noexcept;
+
+    // Check if file is mapped
+    bool isOpen() const noexcept;
+
+    // Access to mapped bytes, data is null for empty file
+    const std::uint8_t* data() const noexcept;
+    std::size_t size() const noexcept;
+
+private:
+    const std::uint8_t* mapped_data = nullptr;
+    std::size_t mapped_size = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
@@ -0,0 +1,142 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Destructor
+inline MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+// Map file
+inline bool MappedFile::open(const std::string& file_name, std::string& error) {
+    close();
+    const HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "Can't open " + file_name + ": error " + std::to_string(GetLastError());
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        error = "Can't get size of " + file_name + ": error " + std::to_string(GetLastError());
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    opened = true;
+    if (file_size.QuadPart == 0) {
+        return true;
+    }
+    const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        error = "Can't map " + file_name + ": error " + std::to_string(GetLastError());
+        close();
+        return false;
+    }
+    mapping_handle = mapping;
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        error = "Can't map " + file_name + ": error " + std::to_string(GetLastError());
+        close();
+        return false;
+    }
+    mapped_data = static_cast<const std::uint8_t*>(view);
+    mapped_size = static_cast<std::size_t>(file_size.QuadPart);
+    return true;
+}
+
+// Unmap file
+inline void MappedFile::close() noexcept {
+    if (mapped_data != nullptr) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+    opened = false;
+}
+
+#else
+
+// Map file
+inline bool MappedFile::open(const std::string& file_name, std::string& error) {
+    close();
+    const int descriptor = ::open(file_name.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        error = "Can't open " + file_name + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(descriptor, &file_stat) != 0) {
+        error = "Can't get size of " + file_name + ": " + std::strerror(errno);
+        ::close(descriptor);
+        return false;
+    }
+    opened = true;
+    if (file_stat.st_size == 0) {
+        ::close(descriptor);
+        return true;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    // Mapping stays valid after descriptor is closed
+    ::close(descriptor);
+    if (view == MAP_FAILED) {
+        error = "Can't map " + file_name + ": " + std::strerror(errno);
+        opened = false;
+        return false;
+    }
+    mapped_data = static_cast<const std::uint8_t*>(view);
+    mapped_size = static_cast<std::size_t>(file_stat.st_size);
+    return true;
+}
+
+// Unmap file
+inline void MappedFile::close() noexcept {
+    if (mapped_data != nullptr) {
+        munmap(const_cast<std::uint8_t*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+    opened = false;
+}
+
+#endif
+
+// Check if file is mapped
+inline bool MappedFile::isOpen() const noexcept {
+    return opened;
+}
+
+// Access to mapped bytes
+inline const std::uint8_t* MappedFile::data() const noexcept {
+    return mapped_data;
+}
+
+inline std::size_t MappedFile::size() const noexcept {
+    return mapped_size;
+}
@@ -3,40 +3,198 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include "arena.h"
+#include "batch_executor.h"
+#include "cost_model.h"
+#include "executor_pool.h"
+#include "loop_accelerator.h"
+#include "perf_counters.h"
 #include "program.h"
+#include "progress_reporter.h"
+#include "result_sink.h"
+#include "search_estimate.h"
+#include "search_stats.h"
+#include "static_pruner.h"
+#include "step_objective.h"
+#include "trace_recorder.h"
+#include "truth_table.h"
 #include "variables.h"
 
 // Template class for program optimization
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+// ProgramClass selects program storage, InlineProgram makes candidate handling in the search loop allocation-free
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
 class Optimize {
 public:
-    using ProgramType = Program<InstructionSet, N, K, T>;
+    using ProgramType = ProgramClass;
     using InputVariablesType = InputVariables<N>;
     using OutputVariablesType = OutputVariables<K>;
+    using LoopAcceleratorType = LoopAccelerator<InstructionSet, N, K, T, ProgramClass>;
+    using BatchExecutorType = BatchExecutor<InstructionSet, N, K, T, ProgramClass>;
+    using ResultSinkType = ResultSink<InstructionSet, N, K, T, ProgramClass>;
+    using ExecutorPoolType = ExecutorPool<InstructionSet, N, K, T, ProgramClass>;
+    using ExecutorContextType = ExecutorContext<InstructionSet, N, K, T, ProgramClass>;
+    using StaticPrunerType = StaticPruner<InstructionSet, N, K, T, ProgramClass>;
+    using TruthTableType = TruthTable<InstructionSet, N, K, T>;
+
+    // Maximum step count after which program is considered as stuck in infinite loop
+    static constexpr std::uint64_t MAX_STEPS = 1000000;
+
+    // Count of candidates verified together on each input
+    static constexpr std::size_t BATCH_SIZE = 256;
+
+    // Count of random candidates verified together by estimate(), smaller batches keep it within its time budget
+    static constexpr std::size_t ESTIMATE_BATCH_SIZE = 64;
+
+    // Default wall time of estimate()
+    static constexpr double DEFAULT_ESTIMATE_SECONDS = 5.0;
 
     // Constructor
     explicit Optimize(const ProgramType& program_arg);
 
-    // Find optimized program that produces same output but with fewer average steps
+    // Find optimized program that produces same output but with lower value of objective, see setObjective()
     // maxProgramSize: maximum size of programs to search
     // Returns optimized program (or original if no better found)
+    // Best valid programs are kept in default top-K sink and printed at the end together with search statistics
     ProgramType speed(unsigned maxProgramSize);
     
-    // Calculate total step count for all input combinations
+    // Same as above, but all valid programs go to the given sink and nothing is printed at the end
+    // Progress of both overloads goes to progress reporter, see getProgressReporter()
+    // Candidates which can't change the sink (see ResultSink::getCostBound()) are rejected as soon as their cost reaches the bound
+    // Bound is cost of the worst of max_kept retained programs, so there is none until the sink is full or while programs are
+    // streamed or stored; only top-1 sink without stream and store bounds candidates by the current best
+    ProgramType speed(unsigned maxProgramSize, ResultSinkType& sink);
+    
+    // Estimate speed() without running it: uniformly random candidates of each size up to maxProgramSize
+    // go through the same pruning and verification, then counts and wall time are extrapolated to the whole space
+    // time_budget_seconds is split evenly between sizes, at least one batch of each size is verified
+    SearchEstimate estimate(unsigned maxProgramSize, double time_budget_seconds = DEFAULT_ESTIMATE_SECONDS, std::uint64_t seed = 1) const;
+    
+    // Calculate total step count for all input combinations, or total cost if cost model is set
     std::uint64_t calculateAverageSteps(const ProgramType& program) const;
+    
+    // Calculate value of objective for all input combinations, it is equal to calculateAverageSteps() for total objective
+    std::uint64_t calculateObjectiveValue(const ProgramType& program) const;
+    
+    // Peak use of arenas during the last speed() call: per-batch arena and arena of sink created by speed(maxProgramSize)
+    std::size_t getArenaPeakBytes() const noexcept;
+    
+    // Measure search phases of speed() by hardware counters, off by default
+    // If counters can't be opened, the search runs without them and SearchStats::hardware_error tells why
+    void setHardwareCountersEnabled(bool enabled) noexcept;
+    
+    // Rank programs by total cost of executed instructions instead of total step count, null restores step count
+    // Cost is used by verification, cost bounds and ranking of results, model must outlive the search
+    void setCostModel(const CostModel* cost_model_arg) noexcept;
+    const CostModel* getCostModel() const noexcept;
+    
+    // Aggregate of per-input step counts or costs which speed() minimises, total by default
+    // Under max objective a candidate is rejected on the first input whose run reaches the cost bound of speed()
+    void setObjective(const StepObjective& objective_arg) noexcept;
+    const StepObjective& getObjective() const noexcept;
+
+    // Name of value of objective under cost model, e.g. "total steps" or "max cost"
+    std::string getCostName() const;
+    
+    // Record spans of speed() phases to recorder, null disables tracing
+    // Recorder must outlive the search, it may be shared by searches running in different threads
+    void setTraceRecorder(TraceRecorder* recorder) noexcept;
+    
+    // Progress reporter of speed(), it may be configured before the search
+    ProgressReporter& getProgressReporter() noexcept;
+    
+    // Map truth table of the original program from directory, or build it and save there for later searches
+    // Verification then reads outputs and step counts of the original program from the table instead of running it
+    // Table always holds step counts, also when cost model is set, so it is shared by searches with any cost model
+    // Returns false and sets error if table can't be saved, the built table is still used from memory then
+    bool loadTruthTable(const std::string& directory, std::string& error);
+    
+    // Truth table of the original program, it is open only after loadTruthTable()
+    const TruthTableType& getTruthTable() const noexcept;
+    
+    // Snapshot of statistics of the running or the last speed() call, elapsed time is measured up to now
+    SearchStats getStats() const;
+    
+    // Check if two programs produce same output for all input combinations
+    // If candidate is valid, also calculate and return total steps or cost via output parameter
+    bool producesSameOutput(const ProgramType& candidate, std::uint64_t& candidate_total_steps) const;
 
 private:
     const ProgramType& original_program;
+    LoopAcceleratorType original_accelerator;
+    
+    // Arena for per-batch temporaries of speed(): loop analysis of candidates and, for PmrProgram, valid candidate copies
+    // It is reset before each batch
+    Arena arena;
+    
+    // Arena for retained programs of sink created by speed(maxProgramSize)
+    Arena sink_arena;
+    
+    // Statistics of speed(), elapsed time of the running search is added by getStats()
+    SearchStats stats;
+    bool searching = false;
+    std::chrono::steady_clock::time_point search_start;
+    std::chrono::steady_clock::time_point size_start;
+    
+    // JSON-lines progress events of speed()
+    ProgressReporter progress;
+    
+    // Hardware counters of search phases, open only during speed() if enabled
+    bool hardware_counters_enabled = false;
+    PerfCounters perf_counters;
+    
+    // Span tracing of speed(), not owned
+    TraceRecorder* trace = nullptr;
+    
+    // Weights of executed instructions, not owned, steps are counted if null
+    const CostModel* cost_model = nullptr;
+    
+    // Aggregate of per-input values minimised by speed()
+    StepObjective objective;
     
-    // Execute program and count steps, return output variables
-    OutputVariablesType executeAndCountSteps(const ProgramType& program, 
+    // Outputs and step counts of the original program, see loadTruthTable()
+    TruthTableType truth_table;
+    
+    // Execute program and count steps, or sum costs of instructions if weights are given, return output variables
+    // Without weights counting loops recognised by accelerator are evaluated in closed form, everything else runs under RabbitTurtle
+    // RabbitTurtle of context is reset to program and input, so no executor is constructed per call
+    // infinite_loop is set if program was stopped by infinite loop detector or step limit
+    OutputVariablesType executeAndCountSteps(const ProgramType& program,
+                                             const LoopAcceleratorType& accelerator,
+                                             ExecutorContextType& context,
                                              const InputVariablesType& input, 
-                                             std::uint64_t& step_count) const;
+                                             std::uint64_t& step_count,
+                                             bool& infinite_loop,
+                                             const CostModel* weights) const;
     
-    // Check if two programs produce same output for all input combinations
-    // If candidate is valid, also calculate and return total steps via output parameter
-    bool producesSameOutput(const ProgramType& candidate, std::uint64_t& candidate_total_steps) const;
+    // Execute original program on input, or read its entry of truth table if it is open
+    // Table holds step counts, so step_count read from it is a step count even if cost model is set
+    OutputVariablesType executeOriginal(ExecutorContextType& context,
+                                        const InputVariablesType& input,
+                                        std::uint64_t& step_count,
+                                        bool& infinite_loop) const;
+    
+    // Count of candidates of the given size, saturated at max value
+    static std::uint64_t getSpaceSize(unsigned program_size);
+    
+    // Count of input combinations, saturated at max value
+    static std::uint64_t getInputCount();
+    
+    // Calculate value of objective of the original program and check if it finishes on at least one input
+    std::uint64_t analyseOriginal(bool& terminates) const;
+    
+    // Add hardware counters since mark to the given phase of the current program size and to totals, mark is moved to now
+    void accountPhase(ESearchPhase phase, HardwareCounters& mark);
+    
+    // Add counters of verified batch to statistics of the current program size and to totals
+    void accountBatch(const BatchExecutorType& batch);
+    
+    // Check all candidates loaded into batch against the original program
+    // Reference output is computed once per input combination for the whole batch
+    void verifyBatch(BatchExecutorType& batch) const;
     
     // Helper: iterate through all input combinations and call callback for each
     template<typename Callback>
@@ -4,53 +4,98 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <limits>
-#include <list>
 #include <iostream>
+#include <memory_resource>
+#include <random>
 #include <utility>
+#include "arena.hpp"
+#include "batch_executor.h"
+#include "batch_executor.hpp"
+#include "cost_model.hpp"
 #include "executor.h"
 #include "executor.hpp"
+#include "executor_pool.h"
+#include "executor_pool.hpp"
 #include "fabric.h"
 #include "full_state.h"
 #include "full_state.hpp"
+#include "loop_accelerator.hpp"
+#include "perf_counters.hpp"
 #include "program.hpp"
 #include "rabbit_turtle.h"
 #include "rabbit_turtle.hpp"
+#include "progress_reporter.hpp"
+#include "result_sink.hpp"
+#include "search_estimate.hpp"
+#include "search_stats.hpp"
+#include "static_pruner.h"
+#include "static_pruner.hpp"
+#include "step_histogram.hpp"
+#include "step_objective.hpp"
+#include "trace_recorder.hpp"
+#include "truth_table.hpp"
 #include "variables.hpp"
 
 // Constructor
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline Optimize<InstructionSet, N, K, T>::Optimize(const ProgramType& program_arg)
-    : original_program(program_arg) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline Optimize<InstructionSet, N, K, T, ProgramClass>::Optimize(const ProgramType& program_arg)
+    : original_program(program_arg), original_accelerator(program_arg) {
 }
 
 // Execute program and count steps, return output variables
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Optimize<InstructionSet, N, K, T>::OutputVariablesType
-Optimize<InstructionSet, N, K, T>::executeAndCountSteps(const ProgramType& program,
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Optimize<InstructionSet, N, K, T, ProgramClass>::OutputVariablesType
+Optimize<InstructionSet, N, K, T, ProgramClass>::executeAndCountSteps(const ProgramType& program,
+                                                          const LoopAcceleratorType& accelerator,
+                                                          ExecutorContextType& context,
                                                           const InputVariablesType& input,
-                                                          std::uint64_t& step_count) const {
-    RabbitTurtle<InstructionSet, N, K, T> rt(program, input);
-    rt.start();
+                                                          std::uint64_t& step_count,
+                                                          bool& infinite_loop,
+                                                          const CostModel* weights) const {
+    infinite_loop = false;
+
+    // Closed-form path: the program has to finish, so step count is derived from the executed instruction count
+    // RabbitTurtle counts iterations in which both rabbit steps succeeded, it is (instruction_count + 1) / 2 - 1
+    // Accelerator knows only instruction count, so weighted cost is summed while running
+    if (!weights && accelerator.isAccelerated()) {
+        OutputVariablesType output;
+        std::uint64_t instruction_count = 0;
+        if (accelerator.run(input, output, instruction_count, 2 * MAX_STEPS + 2)) {
+            step_count = (instruction_count > 0) ? (instruction_count + 1) / 2 - 1 : 0;
+            return output;
+        }
+    }
+
+    auto& rt = context.rabbit_turtle;
+    rt.reset(program, input);
     step_count = 0;
     
-    // Maximum step limit to prevent infinite loops (fallback)
-    const std::uint64_t max_steps = 1000000;
+    if (weights) {
+        std::uint64_t iteration_count = 0;
+        while (rt.execute(*weights, step_count)) {
+            ++iteration_count;
+            if (rt.isInfiniteLoopDetected() || iteration_count > MAX_STEPS) {
+                infinite_loop = true;
+                break;
+            }
+        }
+        return rt.getOutput();
+    }
     
     while (rt.execute()) {
         ++step_count;
         
         // Check if infinite loop detected by RabbitTurtle
-        if (rt.isInfiniteLoopDetected()) {
-            break;
-        }
-        
         // Fallback: prevent infinite loops by setting a maximum step limit
-        if (step_count > max_steps) {
+        if (rt.isInfiniteLoopDetected() || step_count > MAX_STEPS) {
+            infinite_loop = true;
             break;
         }
     }
@@ -58,10 +103,26 @@ Optimize<InstructionSet, N, K, T>::executeAndCountSteps(const ProgramType& progr
     return rt.getOutput();
 }
 
+// Execute original program on input, or read its entry of truth table
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Optimize<InstructionSet, N, K, T, ProgramClass>::OutputVariablesType
+Optimize<InstructionSet, N, K, T, ProgramClass>::executeOriginal(ExecutorContextType& context,
+                                                     const InputVariablesType& input,
+                                                     std::uint64_t& step_count,
+                                                     bool& infinite_loop) const {
+    if (!truth_table.isOpen()) {
+        return executeAndCountSteps(original_program, original_accelerator, context, input, step_count, infinite_loop, cost_model);
+    }
+    const std::uint64_t index = TruthTableType::getIndex(input);
+    step_count = truth_table.getStepCount(index);
+    infinite_loop = truth_table.isInfiniteLoop(index);
+    return truth_table.getOutput(index);
+}
+
 // Helper: iterate through all input combinations and call callback for each
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
 template<typename Callback>
-inline void Optimize<InstructionSet, N, K, T>::forEachInputCombination(Callback&& callback) const {
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::forEachInputCombination(Callback&& callback) const {
     InputVariablesType current;
     
     // Initialize all values to 0
@@ -99,10 +160,12 @@ inline void Optimize<InstructionSet, N, K, T>::forEachInputCombination(Callback&
 
 // Check if two programs produce same output for all input combinations
 // If candidate is valid, also calculate and return total steps via output parameter
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool Optimize<InstructionSet, N, K, T>::producesSameOutput(const ProgramType& candidate, std::uint64_t& candidate_total_steps) const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool Optimize<InstructionSet, N, K, T, ProgramClass>::producesSameOutput(const ProgramType& candidate, std::uint64_t& candidate_total_steps) const {
     bool all_match = true;
     candidate_total_steps = 0;
+    const LoopAcceleratorType candidate_accelerator(candidate);
+    const auto context = ExecutorPoolType::getThreadPool().acquire(candidate);
     
     forEachInputCombination([&](const InputVariablesType& input) {
         if (!all_match) {
@@ -110,35 +173,15 @@ inline bool Optimize<InstructionSet, N, K, T>::producesSameOutput(const ProgramT
         }
         
         std::uint64_t original_steps, candidate_steps;
+        bool original_infinite, candidate_infinite;
         
         // Execute original program
-        RabbitTurtle<InstructionSet, N, K, T> rt_original(original_program, input);
-        rt_original.start();
-        original_steps = 0;
-        const std::uint64_t max_steps = 1000000;
-        bool original_infinite = false;
-        
-        while (rt_original.execute()) {
-            ++original_steps;
-            if (rt_original.isInfiniteLoopDetected() || original_steps > max_steps) {
-                original_infinite = true;
-                break;
-            }
-        }
+        const OutputVariablesType original_output =
+            executeOriginal(*context, input, original_steps, original_infinite);
         
         // Execute candidate program
-        RabbitTurtle<InstructionSet, N, K, T> rt_candidate(candidate, input);
-        rt_candidate.start();
-        candidate_steps = 0;
-        bool candidate_infinite = false;
-        
-        while (rt_candidate.execute()) {
-            ++candidate_steps;
-            if (rt_candidate.isInfiniteLoopDetected() || candidate_steps > max_steps) {
-                candidate_infinite = true;
-                break;
-            }
-        }
+        const OutputVariablesType candidate_output =
+            executeAndCountSteps(candidate, candidate_accelerator, *context, input, candidate_steps, candidate_infinite, cost_model);
         
         // Accumulate candidate steps (only if program is valid)
         candidate_total_steps += candidate_steps;
@@ -149,8 +192,10 @@ inline bool Optimize<InstructionSet, N, K, T>::producesSameOutput(const ProgramT
             return;
         }
         
-        OutputVariablesType original_output = rt_original.getOutput();
-        OutputVariablesType candidate_output = rt_candidate.getOutput();
+        // Both programs are stuck, there is no output to compare
+        if (original_infinite) {
+            return;
+        }
         
         // Compare output variables (ignore temp variables)
         for (unsigned i = 0; i < K; ++i) {
@@ -164,84 +209,502 @@ inline bool Optimize<InstructionSet, N, K, T>::producesSameOutput(const ProgramT
     return all_match;
 }
 
+// Check all candidates loaded into batch against the original program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::verifyBatch(BatchExecutorType& batch) const {
+    batch.start();
+    const auto context = ExecutorPoolType::getThreadPool().acquire(original_program);
+    
+    forEachInputCombination([&](const InputVariablesType& input) {
+        if (!batch.hasValidCandidates()) {
+            return; // Early exit optimization
+        }
+        
+        std::uint64_t original_steps;
+        bool original_infinite;
+        const OutputVariablesType original_output =
+            executeOriginal(*context, input, original_steps, original_infinite);
+        
+        batch.execute(input, original_output, original_infinite);
+    });
+}
+
 // Calculate total step count for all input combinations
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline std::uint64_t Optimize<InstructionSet, N, K, T>::calculateAverageSteps(const ProgramType& program) const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Optimize<InstructionSet, N, K, T, ProgramClass>::calculateAverageSteps(const ProgramType& program) const {
     std::uint64_t total_steps = 0;
+    const LoopAcceleratorType accelerator(program);
+    const auto context = ExecutorPoolType::getThreadPool().acquire(program);
     
     forEachInputCombination([&](const InputVariablesType& input) {
         std::uint64_t step_count;
-        executeAndCountSteps(program, input, step_count);
+        bool infinite_loop;
+        executeAndCountSteps(program, accelerator, *context, input, step_count, infinite_loop, cost_model);
         total_steps += step_count;
     });
     
     return total_steps;
 }
 
+// Calculate value of objective for all input combinations
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Optimize<InstructionSet, N, K, T, ProgramClass>::calculateObjectiveValue(const ProgramType& program) const {
+    std::uint64_t total_steps = 0;
+    std::uint64_t worst_steps = 0;
+    StepHistogram histogram;
+    const LoopAcceleratorType accelerator(program);
+    const auto context = ExecutorPoolType::getThreadPool().acquire(program);
+    
+    forEachInputCombination([&](const InputVariablesType& input) {
+        std::uint64_t step_count;
+        bool infinite_loop;
+        executeAndCountSteps(program, accelerator, *context, input, step_count, infinite_loop, cost_model);
+        total_steps += step_count;
+        worst_steps = std::max(worst_steps, step_count);
+        histogram.add(step_count);
+    });
+    
+    return objective.getValue(total_steps, worst_steps, &histogram);
+}
+
+// Calculate value of objective of the original program and check if it finishes on at least one input
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Optimize<InstructionSet, N, K, T, ProgramClass>::analyseOriginal(bool& terminates) const {
+    std::uint64_t total_steps = 0;
+    std::uint64_t worst_steps = 0;
+    StepHistogram histogram;
+    terminates = false;
+    const auto context = ExecutorPoolType::getThreadPool().acquire(original_program);
+    
+    forEachInputCombination([&](const InputVariablesType& input) {
+        std::uint64_t step_count;
+        bool infinite_loop;
+        // Truth table holds step counts, so cost is measured by running the program
+        if (cost_model) {
+            executeAndCountSteps(original_program, original_accelerator, *context, input, step_count, infinite_loop, cost_model);
+        } else {
+            executeOriginal(*context, input, step_count, infinite_loop);
+        }
+        total_steps += step_count;
+        worst_steps = std::max(worst_steps, step_count);
+        histogram.add(step_count);
+        terminates = terminates || !infinite_loop;
+    });
+    
+    return objective.getValue(total_steps, worst_steps, &histogram);
+}
+
+// Add counters of verified batch to statistics of the current program size and to totals
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::accountBatch(const BatchExecutorType& batch) {
+    SearchCounters delta;
+    const auto& counters = batch.getCounters();
+    delta.inputs_executed = counters.inputs_executed;
+    delta.instructions_executed = counters.instructions_executed;
+    delta.cycle_checks = counters.cycle_checks;
+    delta.accelerated_runs = counters.accelerated_runs;
+    
+    for (std::size_t candidate_index = 0; candidate_index < batch.size(); ++candidate_index) {
+        switch (batch.getResult(candidate_index).reject_reason) {
+            case BatchExecutorType::ERejectReason::None:
+                ++delta.candidates_valid;
+                break;
+            case BatchExecutorType::ERejectReason::OutputMismatch:
+                ++delta.rejected_output_mismatch;
+                break;
+            case BatchExecutorType::ERejectReason::TerminationMismatch:
+                ++delta.rejected_termination_mismatch;
+                break;
+            case BatchExecutorType::ERejectReason::CostBound:
+                ++delta.rejected_cost_bound;
+                break;
+        }
+    }
+    
+    stats.by_program_size.back() += delta;
+    stats.total += delta;
+}
+
+// Add hardware counters since mark to the given phase of the current program size and to totals
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::accountPhase(ESearchPhase phase, HardwareCounters& mark) {
+    if (!perf_counters.isOpen()) {
+        return;
+    }
+    const HardwareCounters now = perf_counters.read();
+    const HardwareCounters delta = now - mark;
+    stats.by_program_size.back().hardware[static_cast<std::size_t>(phase)] += delta;
+    stats.total.hardware[static_cast<std::size_t>(phase)] += delta;
+    mark = now;
+}
+
+// Rank programs by total cost of executed instructions
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::setCostModel(const CostModel* cost_model_arg) noexcept {
+    cost_model = cost_model_arg;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const CostModel* Optimize<InstructionSet, N, K, T, ProgramClass>::getCostModel() const noexcept {
+    return cost_model;
+}
+
+// Aggregate of per-input step counts or costs which speed() minimises
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::setObjective(const StepObjective& objective_arg) noexcept {
+    objective = objective_arg;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const StepObjective& Optimize<InstructionSet, N, K, T, ProgramClass>::getObjective() const noexcept {
+    return objective;
+}
+
+// Name of value of objective under cost model
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::string Optimize<InstructionSet, N, K, T, ProgramClass>::getCostName() const {
+    return objective.toString() + (cost_model == nullptr ? " steps" : " cost");
+}
+
+// Record spans of speed() phases
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::setTraceRecorder(TraceRecorder* recorder) noexcept {
+    trace = recorder;
+}
+
+// Measure search phases by hardware counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void Optimize<InstructionSet, N, K, T, ProgramClass>::setHardwareCountersEnabled(bool enabled) noexcept {
+    hardware_counters_enabled = enabled;
+}
+
+// Peak use of per-batch arena during the last speed() call
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t Optimize<InstructionSet, N, K, T, ProgramClass>::getArenaPeakBytes() const noexcept {
+    return arena.getPeakBytes() + sink_arena.getPeakBytes();
+}
+
+// Access to progress reporter
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ProgressReporter& Optimize<InstructionSet, N, K, T, ProgramClass>::getProgressReporter() noexcept {
+    return progress;
+}
+
+// Map truth table of the original program from directory, or build and save it
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool Optimize<InstructionSet, N, K, T, ProgramClass>::loadTruthTable(const std::string& directory, std::string& error) {
+    const std::string file_name = TruthTableType::getFileName(directory, original_program);
+    std::string ignored_error;
+    if (truth_table.load(file_name, original_program, MAX_STEPS, ignored_error)) {
+        return true;
+    }
+    
+    // Missing or stale table is rebuilt, it holds step counts whatever cost model is set
+    truth_table.create(original_program, MAX_STEPS);
+    const auto context = ExecutorPoolType::getThreadPool().acquire(original_program);
+    forEachInputCombination([&](const InputVariablesType& input) {
+        std::uint64_t step_count;
+        bool infinite_loop;
+        const OutputVariablesType output =
+            executeAndCountSteps(original_program, original_accelerator, *context, input, step_count, infinite_loop, nullptr);
+        truth_table.set(TruthTableType::getIndex(input), output, step_count, infinite_loop);
+    });
+    
+    std::error_code error_code;
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error_code);
+    }
+    if (error_code) {
+        error = "Can't create " + directory + ": " + error_code.message();
+        return false;
+    }
+    if (!truth_table.save(file_name, error)) {
+        return false;
+    }
+    
+    // Mapped table is shared with other searches, so the built one is dropped
+    return truth_table.load(file_name, original_program, MAX_STEPS, error);
+}
+
+// Truth table of the original program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename Optimize<InstructionSet, N, K, T, ProgramClass>::TruthTableType& Optimize<InstructionSet, N, K, T, ProgramClass>::getTruthTable() const noexcept {
+    return truth_table;
+}
+
+// Count of candidates of the given size, saturated at max value
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Optimize<InstructionSet, N, K, T, ProgramClass>::getSpaceSize(unsigned program_size) {
+    const std::uint64_t combination_count = InstructionSet<N, K, T>::getCombinationCount(program_size);
+    std::uint64_t space_size = 1;
+    for (unsigned i = 0; i < program_size; ++i) {
+        if (combination_count != 0 && space_size > std::numeric_limits<std::uint64_t>::max() / combination_count) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        space_size *= combination_count;
+    }
+    return space_size;
+}
+
+// Count of input combinations, saturated at max value
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t Optimize<InstructionSet, N, K, T, ProgramClass>::getInputCount() {
+    std::uint64_t input_count = 1;
+    for (unsigned i = 0; i < N; ++i) {
+        if (input_count > std::numeric_limits<std::uint64_t>::max() / 256) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        input_count *= 256;
+    }
+    return input_count;
+}
+
+// Snapshot of statistics of the running or the last speed() call
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline SearchStats Optimize<InstructionSet, N, K, T, ProgramClass>::getStats() const {
+    SearchStats result = stats;
+    if (searching) {
+        const auto now = std::chrono::steady_clock::now();
+        result.total.elapsed_seconds = std::chrono::duration<double>(now - search_start).count();
+        if (!result.by_program_size.empty()) {
+            result.by_program_size.back().elapsed_seconds = std::chrono::duration<double>(now - size_start).count();
+        }
+    }
+    return result;
+}
+
 // Find optimized program
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Optimize<InstructionSet, N, K, T>::ProgramType
-Optimize<InstructionSet, N, K, T>::speed(unsigned maxProgramSize) {
-    // Calculate total steps for original program
-    std::uint64_t original_total_steps = calculateAverageSteps(original_program);
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Optimize<InstructionSet, N, K, T, ProgramClass>::ProgramType
+Optimize<InstructionSet, N, K, T, ProgramClass>::speed(unsigned maxProgramSize) {
+    sink_arena.reset();
+    sink_arena.resetPeak();
+    ProgramType best_program;
+    {
+        // Replaced entries go back to the pool, so the arena grows only up to the retained entries
+        std::pmr::unsynchronized_pool_resource pool(&sink_arena);
+        ResultSinkType sink(ResultSinkType::EMode::TopK, ResultSinkType::DEFAULT_MAX_KEPT, &pool);
+        sink.setCostName(getCostName());
+        best_program = speed(maxProgramSize, sink);
+        
+        // Output best valid programs
+        std::cout << "\n=== Best Valid Programs (" << sink.getKeptCount() << " of "
+                  << sink.getCount() << " within cost bound) ===" << std::endl;
+        std::cout << sink.dump();
+    }
+    // Peak is kept, so getArenaPeakBytes() still reports it
+    sink_arena.reset();
+    
+    // Output search statistics
+    std::cout << "\n=== Search Statistics ===" << std::endl;
+    std::cout << stats.dump() << std::flush;
+    
+    return best_program;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename Optimize<InstructionSet, N, K, T, ProgramClass>::ProgramType
+Optimize<InstructionSet, N, K, T, ProgramClass>::speed(unsigned maxProgramSize, ResultSinkType& sink) {
+    TraceSpan search_span(trace, "search", "speed");
+    search_span.setArg("max_program_size", maxProgramSize);
+    
+    // Calculate value of objective for original program
+    bool original_terminates;
+    std::uint64_t original_value;
+    {
+        TraceSpan reference_span(trace, "search", "reference");
+        original_value = analyseOriginal(original_terminates);
+    }
     
     ProgramType best_program = original_program;
-    std::uint64_t best_total_steps = original_total_steps;
+    std::uint64_t best_value = original_value;
+    
+    arena.reset();
+    arena.resetPeak();
+    // Sink of speed(maxProgramSize) is already in sink arena, other sinks don't use it
+    sink_arena.resetPeak();
+    
+    const StaticPrunerType pruner(original_terminates);
+    stats = SearchStats{};
+    searching = true;
+    search_start = std::chrono::steady_clock::now();
     
-    // Container to store all valid programs with their step counts
-    std::list<std::pair<ProgramType, std::uint64_t>> valid_programs;
+    // If counters aren't open, phases are not measured
+    if (hardware_counters_enabled) {
+        perf_counters.open(stats.hardware_error);
+    }
+    HardwareCounters phase_mark = perf_counters.read();
     
     // Search through all possible program sizes from 1 to maxProgramSize
     for (unsigned program_size = 1; program_size <= maxProgramSize; ++program_size) {
-        std::cout << "Searching programs of size " << program_size << "..." << std::endl;
-        Fabric<InstructionSet, N, K, T> fabric(program_size);
-        std::uint64_t checked_count = 0;
-        std::uint64_t valid_count = 0;
+        TraceSpan size_span(trace, "search", "program_size");
+        size_span.setArg("program_size", program_size);
+        Fabric<InstructionSet, N, K, T, ProgramClass> fabric(program_size);
         
-        // Iterate through all possible programs of this size
-        do {
-            ProgramType candidate = fabric.generate();
-            ++checked_count;
+        stats.by_program_size.emplace_back();
+        size_start = std::chrono::steady_clock::now();
+        progress.startSize(program_size, getSpaceSize(program_size), best_value);
+        
+        BatchExecutorType batch(program_size, BATCH_SIZE, MAX_STEPS);
+        batch.setMemoryResource(&arena);
+        batch.setCostModel(cost_model);
+        batch.setObjective(objective, getInputCount());
+        bool has_next = true;
+        
+        // Iterate through all possible programs of this size, batch by batch
+        while (has_next) {
+            // Accelerators of the previous batch are released before their memory is reused
+            batch.clear();
+            arena.reset();
+            {
+                // Pruning is interleaved with enumeration, so both are in one span
+                TraceSpan generate_span(trace, "batch", "generate_and_prune");
+                const std::uint64_t generated_before = stats.total.candidates_generated;
+                do {
+                    const ProgramType& candidate = fabric.getProgram();
+                    ++stats.by_program_size.back().candidates_generated;
+                    ++stats.total.candidates_generated;
+                    
+                    // Candidates which can't be valid are not executed
+                    const EPruneReason prune_reason = pruner.check(candidate);
+                    if (prune_reason == EPruneReason::None) {
+                        batch.add(candidate);
+                    } else {
+                        ++stats.by_program_size.back().candidates_pruned[static_cast<std::size_t>(prune_reason)];
+                        ++stats.total.candidates_pruned[static_cast<std::size_t>(prune_reason)];
+                    }
+                    has_next = fabric.next();
+                } while (has_next && !batch.full());
+                generate_span.setArg("generated", stats.total.candidates_generated - generated_before);
+                generate_span.setArg("pruned", stats.total.candidates_generated - generated_before - batch.size());
+            }
+            accountPhase(ESearchPhase::Generate, phase_mark);
             
-            // Check if candidate produces same output and get total steps
-            std::uint64_t candidate_total_steps = 0;
-            if (producesSameOutput(candidate, candidate_total_steps)) {
-                ++valid_count;
-                // Add to list of valid programs with step count
-                valid_programs.push_back(std::make_pair(candidate, candidate_total_steps));
-                
-                // If candidate is better, update best
-                if (candidate_total_steps < best_total_steps) {
-                    std::cout << "Found better program (size " << program_size 
-                              << ", total steps: " << candidate_total_steps 
-                              << " < " << best_total_steps << ")" << std::endl;
-                    best_program = candidate;
-                    best_total_steps = candidate_total_steps;
-                }
+            if (batch.empty()) {
+                progress.update(stats.by_program_size.back(), best_value);
+                continue;
             }
             
-            // Print progress every 100 programs
-            if (checked_count % 100 == 0) {
-                std::cout << "  Checked " << checked_count << " programs, found " 
-                          << valid_count << " valid, best total steps: " << best_total_steps << std::endl;
+            // Check if candidates produce same output and get value of objective
+            // Candidates which can't get into the sink are rejected as soon as they reach its cost bound
+            batch.setCostBound(sink.getCostBound());
+            {
+                TraceSpan verify_span(trace, "batch", "verify");
+                verify_span.setArg("candidates", batch.size());
+                verifyBatch(batch);
             }
-        } while (fabric.next());
+            accountPhase(ESearchPhase::Verify, phase_mark);
+            accountBatch(batch);
+            
+            {
+                TraceSpan collect_span(trace, "batch", "sink");
+                std::uint64_t valid_count = 0;
+                for (std::size_t candidate_index = 0; candidate_index < batch.size(); ++candidate_index) {
+                    const auto& result = batch.getResult(candidate_index);
+                    if (result.valid) {
+                        ++valid_count;
+                        const std::uint64_t candidate_value = batch.getObjectiveValue(candidate_index);
+                        const ProgramType candidate = batch.getProgram(candidate_index, &arena);
+                        
+                        // If candidate is better, update best
+                        if (candidate_value < best_value) {
+                            best_program = candidate;
+                            best_value = candidate_value;
+                            progress.reportBest(stats.by_program_size.back(), best_value);
+                        }
+                        
+                        // Pass valid program with value of objective to the sink
+                        sink.add(candidate, candidate_value);
+                    }
+                }
+                collect_span.setArg("valid", valid_count);
+            }
+            accountPhase(ESearchPhase::Collect, phase_mark);
+            
+            // Progress event is emitted only when its interval has elapsed
+            progress.update(stats.by_program_size.back(), best_value);
+        }
         
-        std::cout << "Size " << program_size << " complete: checked " << checked_count 
-                  << " programs, found " << valid_count << " valid" << std::endl;
+        stats.by_program_size.back().elapsed_seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - size_start).count();
+        progress.finishSize(stats.by_program_size.back(), best_value);
+
+        // Checkpoint: results and events of the finished size reach their files
+        sink.flush();
+        progress.flush();
     }
     
-    // Output all valid programs
-    std::cout << "\n=== All Valid Programs (" << valid_programs.size() << " total) ===" << std::endl;
-    std::uint64_t program_index = 0;
-    for (const auto& program_pair : valid_programs) {
-        const auto& program = program_pair.first;
-        std::uint64_t program_steps = program_pair.second;
-        std::cout << "\n--- Valid Program #" << program_index << " (total steps: " << program_steps << ") ---" << std::endl;
-        std::cout << program.dump() << std::endl;
-        ++program_index;
-    }
+    stats.total.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - search_start).count();
+    searching = false;
+    perf_counters.close();
     
     return best_program;
 }
 
+
+// Estimate speed() from random samples
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline SearchEstimate Optimize<InstructionSet, N, K, T, ProgramClass>::estimate(unsigned maxProgramSize, double time_budget_seconds, std::uint64_t seed) const {
+    SearchEstimate result;
+    if (maxProgramSize == 0) {
+        return result;
+    }
+    
+    bool original_terminates;
+    analyseOriginal(original_terminates);
+    const StaticPrunerType pruner(original_terminates);
+    std::mt19937_64 random(seed);
+    const double size_budget_seconds = time_budget_seconds / static_cast<double>(maxProgramSize);
+    
+    for (unsigned program_size = 1; program_size <= maxProgramSize; ++program_size) {
+        Fabric<InstructionSet, N, K, T, ProgramClass> fabric(program_size);
+        SizeEstimate size_estimate;
+        size_estimate.program_size = program_size;
+        size_estimate.space_size = std::pow(static_cast<double>(fabric.getCombinationCount()), static_cast<double>(program_size));
+        if (fabric.getCombinationCount() == 0) {
+            result.by_program_size.push_back(size_estimate);
+            continue;
+        }
+        
+        // Uniform index of each position gives uniform rank of the whole program
+        std::uniform_int_distribution<std::uint64_t> distribution(0, fabric.getCombinationCount() - 1);
+        std::vector<std::uint64_t> combination_indices(program_size);
+        BatchExecutorType batch(program_size, ESTIMATE_BATCH_SIZE, MAX_STEPS);
+        batch.setCostModel(cost_model);
+        batch.setObjective(objective, getInputCount());
+        
+        const auto start = std::chrono::steady_clock::now();
+        double elapsed_seconds = 0.0;
+        do {
+            batch.clear();
+            for (std::size_t i = 0; i < ESTIMATE_BATCH_SIZE; ++i) {
+                for (std::uint64_t& combination_index : combination_indices) {
+                    combination_index = distribution(random);
+                }
+                fabric.seek(combination_indices);
+                ++size_estimate.sampled;
+                if (pruner.check(fabric.getProgram()) != EPruneReason::None) {
+                    ++size_estimate.sampled_pruned;
+                } else {
+                    batch.add(fabric.getProgram());
+                }
+            }
+            if (!batch.empty()) {
+                verifyBatch(batch);
+                for (std::size_t candidate_index = 0; candidate_index < batch.size(); ++candidate_index) {
+                    if (batch.getResult(candidate_index).valid) {
+                        ++size_estimate.sampled_valid;
+                    }
+                }
+            }
+            elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            // Sample as large as the space itself adds no accuracy
+        } while (elapsed_seconds < size_budget_seconds && static_cast<double>(size_estimate.sampled) < size_estimate.space_size);
+        
+        size_estimate.sample_seconds = elapsed_seconds;
+        result.by_program_size.push_back(size_estimate);
+    }
+    
+    return result;
+}
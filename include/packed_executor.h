@@ -0,0 +1,54 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "packed_program.h"
+#include "variables.h"
+
+// Template class for executing packed programs directly, without decoding them back to instruction set
+// Variables are kept in one flat array indexed the same way as packed operands
+template<unsigned N, unsigned K, unsigned T>
+class PackedExecutor {
+public:
+    using PackedProgramType = PackedProgram<N, K, T>;
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    using InputVariablesType = InputVariables<N>;
+    using OutputVariablesType = OutputVariables<K>;
+    using EAddressType = typename PackedInstructionType::EAddressType;
+
+    static constexpr unsigned VARIABLE_COUNT = N + K + T;
+
+    // Constructors
+    explicit PackedExecutor(const PackedProgramType& program_arg, const InputVariablesType& input_arg);
+
+    // Access to program
+    const PackedProgramType& getProgram() const;
+
+    // Access to state
+    std::size_t getInstructionPointer() const noexcept;
+    std::uint8_t getValue(unsigned index) const;
+    OutputVariablesType getOutput() const;
+
+    // Execute current instruction
+    // Returns false if program is finished, true otherwise
+    bool execute();
+
+    // Compare state with another executor
+    bool isSame(const PackedExecutor& other) const;
+
+private:
+    const PackedProgramType& program;
+    std::array<std::uint8_t, VARIABLE_COUNT> values;
+    std::size_t instruction_pointer = 0;
+
+    // Flat index of the first variable of array and its size
+    static unsigned getArrayBase(EAddressType array_type) noexcept;
+    static unsigned getArraySize(EAddressType array_type) noexcept;
+
+    // Conditional jump to target
+    void jumpIf(bool condition, unsigned target) noexcept;
+};
@@ -0,0 +1,226 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include "packed_executor.h"
+#include "packed_program.hpp"
+
+// Constructors
+template<unsigned N, unsigned K, unsigned T>
+inline PackedExecutor<N, K, T>::PackedExecutor(const PackedProgramType& program_arg, const InputVariablesType& input_arg)
+    : program(program_arg), values{} {
+    // Output and temp variables are zero-initialized
+    for (unsigned i = 0; i < N; ++i) {
+        values[i] = input_arg.values[i];
+    }
+}
+
+// Access to program
+template<unsigned N, unsigned K, unsigned T>
+inline const typename PackedExecutor<N, K, T>::PackedProgramType& PackedExecutor<N, K, T>::getProgram() const {
+    return program;
+}
+
+// Access to state
+template<unsigned N, unsigned K, unsigned T>
+inline std::size_t PackedExecutor<N, K, T>::getInstructionPointer() const noexcept {
+    return instruction_pointer;
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline std::uint8_t PackedExecutor<N, K, T>::getValue(unsigned index) const {
+    assert(index < VARIABLE_COUNT);
+    return values[index];
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline typename PackedExecutor<N, K, T>::OutputVariablesType PackedExecutor<N, K, T>::getOutput() const {
+    OutputVariablesType output;
+    for (unsigned i = 0; i < K; ++i) {
+        output.values[i] = values[N + i];
+    }
+    return output;
+}
+
+// Execute current instruction
+template<unsigned N, unsigned K, unsigned T>
+inline bool PackedExecutor<N, K, T>::execute() {
+    if (instruction_pointer >= program.size()) {
+        return false;
+    }
+
+    const PackedInstructionType instruction = program[instruction_pointer];
+    const unsigned operand1 = instruction.getOperand1();
+    const unsigned operand2 = instruction.getOperand2();
+    const unsigned extra = instruction.getExtra();
+
+    switch (instruction.getOpcode()) {
+        case EPackedOpcode::Add:
+            values[extra] = static_cast<std::uint8_t>(values[operand1] + values[operand2]);
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Sub:
+            values[extra] = static_cast<std::uint8_t>(values[operand1] - values[operand2]);
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Mul:
+            values[extra] = static_cast<std::uint8_t>(values[operand1] * values[operand2]);
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Div:
+            values[extra] = (values[operand2] != 0) ? static_cast<std::uint8_t>(values[operand1] / values[operand2]) : 0;
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Move:
+            values[operand2] = values[operand1];
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Swap: {
+            const std::uint8_t value1 = values[operand1];
+            values[operand1] = values[operand2];
+            values[operand2] = value1;
+            ++instruction_pointer;
+            break;
+        }
+        case EPackedOpcode::Goto:
+            instruction_pointer = extra;
+            break;
+        case EPackedOpcode::JumpIfGreater:
+            jumpIf(values[operand1] > values[operand2], extra);
+            break;
+        case EPackedOpcode::JumpIfLess:
+            jumpIf(values[operand1] < values[operand2], extra);
+            break;
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+            jumpIf(values[operand1] >= values[operand2], extra);
+            break;
+        case EPackedOpcode::JumpIfLessOrEqual:
+            jumpIf(values[operand1] <= values[operand2], extra);
+            break;
+        case EPackedOpcode::JumpIfEqual:
+            jumpIf(values[operand1] == values[operand2], extra);
+            break;
+        case EPackedOpcode::JumpIfZero:
+            jumpIf(values[operand1] == 0, extra);
+            break;
+        case EPackedOpcode::LoadIndirect: {
+            // operand1 holds index, operand2 receives value, out of bounds index loads 0
+            const EAddressType array_type = instruction.getArrayType();
+            const std::uint8_t index = values[operand1];
+            values[operand2] = (index < getArraySize(array_type)) ? values[getArrayBase(array_type) + index] : 0;
+            ++instruction_pointer;
+            break;
+        }
+        case EPackedOpcode::StoreIndirect: {
+            // operand1 holds value, operand2 holds index, out of bounds index is ignored
+            const EAddressType array_type = instruction.getArrayType();
+            const std::uint8_t index = values[operand2];
+            if (index < getArraySize(array_type)) {
+                values[getArrayBase(array_type) + index] = values[operand1];
+            }
+            ++instruction_pointer;
+            break;
+        }
+        case EPackedOpcode::Inc:
+            ++values[operand1];
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::Dec:
+            --values[operand1];
+            ++instruction_pointer;
+            break;
+        case EPackedOpcode::SwapIndirect: {
+            const EAddressType array_type = instruction.getArrayType();
+            const unsigned array_size = getArraySize(array_type);
+            const std::uint8_t index1 = values[operand1];
+            const std::uint8_t index2 = values[operand2];
+            if (index1 < array_size && index2 < array_size) {
+                const unsigned base = getArrayBase(array_type);
+                const std::uint8_t value1 = values[base + index1];
+                values[base + index1] = values[base + index2];
+                values[base + index2] = value1;
+            }
+            ++instruction_pointer;
+            break;
+        }
+        case EPackedOpcode::JumpIfLessIndirect:
+        case EPackedOpcode::JumpIfGreaterIndirect:
+        case EPackedOpcode::JumpIfEqualIndirect: {
+            // Out of bounds indices never jump
+            const EAddressType array_type = instruction.getArrayType();
+            const unsigned array_size = getArraySize(array_type);
+            const std::uint8_t index1 = values[operand1];
+            const std::uint8_t index2 = values[operand2];
+            bool condition = false;
+            if (index1 < array_size && index2 < array_size) {
+                const unsigned base = getArrayBase(array_type);
+                const std::uint8_t value1 = values[base + index1];
+                const std::uint8_t value2 = values[base + index2];
+                switch (instruction.getOpcode()) {
+                    case EPackedOpcode::JumpIfLessIndirect: condition = value1 < value2; break;
+                    case EPackedOpcode::JumpIfGreaterIndirect: condition = value1 > value2; break;
+                    default: condition = value1 == value2; break;
+                }
+            }
+            jumpIf(condition, extra);
+            break;
+        }
+        case EPackedOpcode::SetC:
+            values[operand1] = static_cast<std::uint8_t>(extra);
+            ++instruction_pointer;
+            break;
+        default:
+            assert(false && "Unknown packed opcode");
+            ++instruction_pointer;
+            break;
+    }
+
+    // Check instruction pointer after execution, as instruction may have modified it
+    return instruction_pointer < program.size();
+}
+
+// Compare state with another executor
+template<unsigned N, unsigned K, unsigned T>
+inline bool PackedExecutor<N, K, T>::isSame(const PackedExecutor& other) const {
+    return instruction_pointer == other.instruction_pointer && values == other.values;
+}
+
+// Flat index of the first variable of array
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedExecutor<N, K, T>::getArrayBase(EAddressType array_type) noexcept {
+    switch (array_type) {
+        case EAddressType::Input:
+            return 0;
+        case EAddressType::Output:
+            return N;
+        case EAddressType::Temp:
+            return N + K;
+    }
+    return 0;
+}
+
+// Size of array
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedExecutor<N, K, T>::getArraySize(EAddressType array_type) noexcept {
+    switch (array_type) {
+        case EAddressType::Input:
+            return N;
+        case EAddressType::Output:
+            return K;
+        case EAddressType::Temp:
+            return T;
+    }
+    return 0;
+}
+
+// Conditional jump to target
+template<unsigned N, unsigned K, unsigned T>
+inline void PackedExecutor<N, K, T>::jumpIf(bool condition, unsigned target) noexcept {
+    if (condition) {
+        instruction_pointer = target;
+    } else {
+        ++instruction_pointer;
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstdint>
+#include "address.h"
+
+// Opcodes of packed instructions, common for all instruction sets
+// Instructions with the same name in different instruction sets have the same semantics
+enum class EPackedOpcode : std::uint8_t {
+    Add = 0,
+    Sub = 1,
+    Mul = 2,
+    Div = 3,
+    Move = 4,
+    Swap = 5,
+    Goto = 6,
+    JumpIfGreater = 7,
+    JumpIfLess = 8,
+    JumpIfGreaterOrEqual = 9,
+    JumpIfLessOrEqual = 10,
+    JumpIfEqual = 11,
+    JumpIfZero = 12,
+    LoadIndirect = 13,
+    StoreIndirect = 14,
+    Inc = 15,
+    Dec = 16,
+    SwapIndirect = 17,
+    JumpIfLessIndirect = 18,
+    JumpIfGreaterIndirect = 19,
+    JumpIfEqualIndirect = 20,
+    SetC = 21
+};
+
+// Identifiers of instruction sets, they are stored in serialized programs and must never be renumbered
+enum class EInstructionSetId : std::uint8_t {
+    B0 = 0,
+    B1 = 1,
+    S0 = 2
+};
+
+// Instruction packed into one 32-bit word
+// Layout from the least significant bit:
+// * opcode     - 5 bits
+// * operand1   - 6 bits, flat variable index: input, then output, then temp variables
+// * operand2   - 6 bits, flat variable index
+// * array type - 2 bits, array of indirect instructions
+// * extra      - 13 bits, third operand, jump target or constant depending on opcode
+template<unsigned N, unsigned K, unsigned T>
+struct PackedInstruction {
+    using AddressType = Address<N, K, T>;
+    using EAddressType = typename AddressType::EAddressType;
+
+    static constexpr unsigned OPCODE_BITS = 5;
+    static constexpr unsigned OPERAND_BITS = 6;
+    static constexpr unsigned ARRAY_TYPE_BITS = 2;
+    static constexpr unsigned EXTRA_BITS = 13;
+
+    static constexpr unsigned OPERAND1_SHIFT = OPCODE_BITS;
+    static constexpr unsigned OPERAND2_SHIFT = OPERAND1_SHIFT + OPERAND_BITS;
+    static constexpr unsigned ARRAY_TYPE_SHIFT = OPERAND2_SHIFT + OPERAND_BITS;
+    static constexpr unsigned EXTRA_SHIFT = ARRAY_TYPE_SHIFT + ARRAY_TYPE_BITS;
+
+    static constexpr unsigned MAX_VARIABLE_COUNT = 1u << OPERAND_BITS;
+    static constexpr unsigned MAX_EXTRA = (1u << EXTRA_BITS) - 1;
+
+    static_assert(EXTRA_SHIFT + EXTRA_BITS == 32, "Packed instruction must fill exactly 32 bits");
+    static_assert(N + K + T <= MAX_VARIABLE_COUNT, "Too many variables for packed instruction operand");
+
+    std::uint32_t word = 0;
+
+    // Build packed instruction from fields
+    static PackedInstruction make(EPackedOpcode opcode, unsigned operand1 = 0, unsigned operand2 = 0,
+                                  EAddressType array_type = EAddressType::Input, unsigned extra = 0);
+
+    // Access to fields
+    EPackedOpcode getOpcode() const noexcept;
+    unsigned getOperand1() const noexcept;
+    unsigned getOperand2() const noexcept;
+    EAddressType getArrayType() const noexcept;
+    unsigned getExtra() const noexcept;
+
+    // Check if instruction may change the instruction pointer, its target is in extra field
+    bool isJump() const noexcept;
+
+    // Check if instruction always changes the instruction pointer
+    bool isUnconditionalJump() const noexcept;
+
+    // Convert between address and flat variable index
+    static unsigned packAddress(const AddressType& address);
+    static AddressType unpackAddress(unsigned index);
+};
@@ -0,0 +1,95 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include "address.hpp"
+#include "packed_instruction.h"
+
+// Build packed instruction from fields
+template<unsigned N, unsigned K, unsigned T>
+inline PackedInstruction<N, K, T> PackedInstruction<N, K, T>::make(EPackedOpcode opcode, unsigned operand1, unsigned operand2,
+                                                                   EAddressType array_type, unsigned extra) {
+    assert(operand1 < MAX_VARIABLE_COUNT && operand2 < MAX_VARIABLE_COUNT);
+    assert(extra <= MAX_EXTRA);
+    PackedInstruction result;
+    result.word = static_cast<std::uint32_t>(opcode)
+        | (static_cast<std::uint32_t>(operand1) << OPERAND1_SHIFT)
+        | (static_cast<std::uint32_t>(operand2) << OPERAND2_SHIFT)
+        | (static_cast<std::uint32_t>(array_type) << ARRAY_TYPE_SHIFT)
+        | (static_cast<std::uint32_t>(extra) << EXTRA_SHIFT);
+    return result;
+}
+
+// Access to fields
+template<unsigned N, unsigned K, unsigned T>
+inline EPackedOpcode PackedInstruction<N, K, T>::getOpcode() const noexcept {
+    return static_cast<EPackedOpcode>(word & ((1u << OPCODE_BITS) - 1));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedInstruction<N, K, T>::getOperand1() const noexcept {
+    return (word >> OPERAND1_SHIFT) & ((1u << OPERAND_BITS) - 1);
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedInstruction<N, K, T>::getOperand2() const noexcept {
+    return (word >> OPERAND2_SHIFT) & ((1u << OPERAND_BITS) - 1);
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline typename PackedInstruction<N, K, T>::EAddressType PackedInstruction<N, K, T>::getArrayType() const noexcept {
+    return static_cast<EAddressType>((word >> ARRAY_TYPE_SHIFT) & ((1u << ARRAY_TYPE_BITS) - 1));
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedInstruction<N, K, T>::getExtra() const noexcept {
+    return word >> EXTRA_SHIFT;
+}
+
+// Check if instruction may change the instruction pointer
+template<unsigned N, unsigned K, unsigned T>
+inline bool PackedInstruction<N, K, T>::isJump() const noexcept {
+    switch (getOpcode()) {
+        case EPackedOpcode::Goto:
+        case EPackedOpcode::JumpIfGreater:
+        case EPackedOpcode::JumpIfLess:
+        case EPackedOpcode::JumpIfGreaterOrEqual:
+        case EPackedOpcode::JumpIfLessOrEqual:
+        case EPackedOpcode::JumpIfEqual:
+        case EPackedOpcode::JumpIfZero:
+        case EPackedOpcode::JumpIfLessIndirect:
+        case EPackedOpcode::JumpIfGreaterIndirect:
+        case EPackedOpcode::JumpIfEqualIndirect:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Check if instruction always changes the instruction pointer
+template<unsigned N, unsigned K, unsigned T>
+inline bool PackedInstruction<N, K, T>::isUnconditionalJump() const noexcept {
+    return getOpcode() == EPackedOpcode::Goto;
+}
+
+// Convert address to flat variable index
+template<unsigned N, unsigned K, unsigned T>
+inline unsigned PackedInstruction<N, K, T>::packAddress(const AddressType& address) {
+    switch (address.address_type) {
+        case EAddressType::Input:
+            return address.address;
+        case EAddressType::Output:
+            return N + address.address;
+        case EAddressType::Temp:
+            return N + K + address.address;
+    }
+    return 0;
+}
+
+// Convert flat variable index to address
+template<unsigned N, unsigned K, unsigned T>
+inline typename PackedInstruction<N, K, T>::AddressType PackedInstruction<N, K, T>::unpackAddress(unsigned index) {
+    return decodeAddress<N, K, T>(index);
+}
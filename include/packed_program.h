@@ -0,0 +1,46 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "packed_instruction.h"
+#include "program.h"
+
+// Template class for program of packed instructions
+// Packed form doesn't depend on instruction set, each instruction takes 4 bytes
+template<unsigned N, unsigned K, unsigned T>
+class PackedProgram {
+public:
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+    using Instructions = std::vector<PackedInstructionType>;
+    using size_type = typename Instructions::size_type;
+
+    // Constructors
+    PackedProgram() = default;
+
+    // Encode program, instruction set must provide encode()
+    template<template<unsigned, unsigned, unsigned> class InstructionSet>
+    explicit PackedProgram(const Program<InstructionSet, N, K, T>& program);
+
+    // Decode program, instruction set must provide decode() and support all used opcodes
+    template<template<unsigned, unsigned, unsigned> class InstructionSet>
+    Program<InstructionSet, N, K, T> decode() const;
+
+    // Add instruction
+    void add(const PackedInstructionType& instruction);
+
+    // Access to instructions
+    const PackedInstructionType& operator[](size_type index) const;
+
+    // Program size
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    // Clear
+    void clear() noexcept;
+
+private:
+    Instructions instructions;
+};
@@ -0,0 +1,59 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include "packed_instruction.hpp"
+#include "packed_program.h"
+
+// Encode program
+template<unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet>
+inline PackedProgram<N, K, T>::PackedProgram(const Program<InstructionSet, N, K, T>& program) {
+    instructions.reserve(program.size());
+    for (const auto& instruction : program) {
+        instructions.push_back(instruction.encode());
+    }
+}
+
+// Decode program
+template<unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet>
+inline Program<InstructionSet, N, K, T> PackedProgram<N, K, T>::decode() const {
+    Program<InstructionSet, N, K, T> program(instructions.size());
+    for (const PackedInstructionType& instruction : instructions) {
+        program.add(InstructionSet<N, K, T>::decode(instruction));
+    }
+    return program;
+}
+
+// Add instruction
+template<unsigned N, unsigned K, unsigned T>
+inline void PackedProgram<N, K, T>::add(const PackedInstructionType& instruction) {
+    instructions.push_back(instruction);
+}
+
+// Access to instructions
+template<unsigned N, unsigned K, unsigned T>
+inline const typename PackedProgram<N, K, T>::PackedInstructionType& PackedProgram<N, K, T>::operator[](size_type index) const {
+    assert(index < instructions.size());
+    return instructions[index];
+}
+
+// Program size
+template<unsigned N, unsigned K, unsigned T>
+inline typename PackedProgram<N, K, T>::size_type PackedProgram<N, K, T>::size() const noexcept {
+    return instructions.size();
+}
+
+template<unsigned N, unsigned K, unsigned T>
+inline bool PackedProgram<N, K, T>::empty() const noexcept {
+    return instructions.empty();
+}
+
+// Clear
+template<unsigned N, unsigned K, unsigned T>
+inline void PackedProgram<N, K, T>::clear() noexcept {
+    instructions.clear();
+}
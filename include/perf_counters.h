@@ -0,0 +1,83 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hardware events counted by PerfCounters
+enum class EHardwareCounter : std::uint8_t {
+    Cycles,
+    Instructions,
+    Branches,
+    BranchMisses,
+    CacheReferences,
+    CacheMisses
+};
+
+// Values of hardware counters, some counters may be unavailable on the given machine
+struct HardwareCounters {
+    static constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(EHardwareCounter::CacheMisses) + 1;
+
+    std::array<std::uint64_t, COUNTER_COUNT> values{}; // Indexed by EHardwareCounter
+    std::array<bool, COUNTER_COUNT> available{};
+
+    // Access to counter
+    bool isAvailable(EHardwareCounter counter) const noexcept;
+    std::uint64_t get(EHardwareCounter counter) const noexcept;
+
+    // Check if at least one counter is available
+    bool hasAny() const noexcept;
+
+    // Derived ratios, 0 if counters they depend on are unavailable or zero
+    double getIpc() const noexcept;
+    double getBranchMissRate() const noexcept;
+    double getCacheMissRate() const noexcept;
+
+    // Accumulate counters, counter stays available only if it is available in both operands
+    // Empty operand which has no available counter at all is ignored
+    HardwareCounters& operator+=(const HardwareCounters& other) noexcept;
+
+    // Difference between two readings of the same PerfCounters
+    HardwareCounters operator-(const HardwareCounters& other) const noexcept;
+
+    // Dump ratios and raw values of available counters as one line text representation
+    std::string dump() const;
+};
+
+// Name of hardware counter
+const char* getHardwareCounterName(EHardwareCounter counter) noexcept;
+
+// Group of Linux perf_event_open counters of the calling thread, user space only
+// Counters run from open() till the object is destroyed, phases are measured as difference of two read() results
+// On other platforms and when the kernel refuses access open() fails and read() returns no available counter
+class PerfCounters {
+public:
+    // Constructors
+    PerfCounters() = default;
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Open and start all counters which are supported, returns false with error if none could be opened
+    bool open(std::string& error);
+
+    // Close all counters
+    void close() noexcept;
+
+    // Check if at least one counter is open
+    bool isOpen() const noexcept;
+
+    // Read current values, values are scaled if the kernel multiplexed counters
+    HardwareCounters read() const noexcept;
+
+private:
+    // Group leader first, then other open counters, only first open_count entries are used
+    std::array<int, HardwareCounters::COUNTER_COUNT> descriptors{};
+    std::array<EHardwareCounter, HardwareCounters::COUNTER_COUNT> counters{};
+    std::size_t open_count = 0;
+};
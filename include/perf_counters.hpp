@@ -0,0 +1,250 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Access to counter
+inline bool HardwareCounters::isAvailable(EHardwareCounter counter) const noexcept {
+    return available[static_cast<std::size_t>(counter)];
+}
+
+inline std::uint64_t HardwareCounters::get(EHardwareCounter counter) const noexcept {
+    return values[static_cast<std::size_t>(counter)];
+}
+
+// Check if at least one counter is available
+inline bool HardwareCounters::hasAny() const noexcept {
+    for (const bool counter_available : available) {
+        if (counter_available) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Instructions per cycle
+inline double HardwareCounters::getIpc() const noexcept {
+    if (!isAvailable(EHardwareCounter::Cycles) || !isAvailable(EHardwareCounter::Instructions) || get(EHardwareCounter::Cycles) == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(get(EHardwareCounter::Instructions)) / static_cast<double>(get(EHardwareCounter::Cycles));
+}
+
+// Share of mispredicted branches
+inline double HardwareCounters::getBranchMissRate() const noexcept {
+    if (!isAvailable(EHardwareCounter::Branches) || !isAvailable(EHardwareCounter::BranchMisses) || get(EHardwareCounter::Branches) == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(get(EHardwareCounter::BranchMisses)) / static_cast<double>(get(EHardwareCounter::Branches));
+}
+
+// Share of cache references which missed
+inline double HardwareCounters::getCacheMissRate() const noexcept {
+    if (!isAvailable(EHardwareCounter::CacheReferences) || !isAvailable(EHardwareCounter::CacheMisses) || get(EHardwareCounter::CacheReferences) == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(get(EHardwareCounter::CacheMisses)) / static_cast<double>(get(EHardwareCounter::CacheReferences));
+}
+
+// Accumulate counters
+inline HardwareCounters& HardwareCounters::operator+=(const HardwareCounters& other) noexcept {
+    if (!other.hasAny()) {
+        return *this;
+    }
+    const bool was_empty = !hasAny();
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        values[i] += other.values[i];
+        available[i] = other.available[i] && (was_empty || available[i]);
+    }
+    return *this;
+}
+
+// Difference between two readings
+inline HardwareCounters HardwareCounters::operator-(const HardwareCounters& other) const noexcept {
+    HardwareCounters result;
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        result.available[i] = available[i] && other.available[i];
+        // Scaled values of multiplexed counters may go slightly backwards
+        result.values[i] = result.available[i] && values[i] > other.values[i] ? values[i] - other.values[i] : 0;
+    }
+    return result;
+}
+
+// Dump ratios and raw values of available counters
+inline std::string HardwareCounters::dump() const {
+    std::ostringstream oss;
+    if (!hasAny()) {
+        oss << "unavailable";
+        return oss.str();
+    }
+    const char* separator = "";
+    if (isAvailable(EHardwareCounter::Cycles) && isAvailable(EHardwareCounter::Instructions)) {
+        oss << "IPC " << getIpc();
+        separator = ", ";
+    }
+    if (isAvailable(EHardwareCounter::Branches) && isAvailable(EHardwareCounter::BranchMisses)) {
+        oss << separator << "branch misses " << getBranchMissRate() * 100.0 << '%';
+        separator = ", ";
+    }
+    if (isAvailable(EHardwareCounter::CacheReferences) && isAvailable(EHardwareCounter::CacheMisses)) {
+        oss << separator << "cache misses " << getCacheMissRate() * 100.0 << '%';
+        separator = ", ";
+    }
+    oss << separator << '(';
+    separator = "";
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i) {
+        if (available[i]) {
+            oss << separator << getHardwareCounterName(static_cast<EHardwareCounter>(i)) << ' ' << values[i];
+            separator = ", ";
+        }
+    }
+    oss << ')';
+    return oss.str();
+}
+
+// Name of hardware counter
+inline const char* getHardwareCounterName(EHardwareCounter counter) noexcept {
+    switch (counter) {
+        case EHardwareCounter::Cycles:
+            return "cycles";
+        case EHardwareCounter::Instructions:
+            return "instructions";
+        case EHardwareCounter::Branches:
+            return "branches";
+        case EHardwareCounter::BranchMisses:
+            return "branch_misses";
+        case EHardwareCounter::CacheReferences:
+            return "cache_references";
+        case EHardwareCounter::CacheMisses:
+            return "cache_misses";
+    }
+    return "unknown";
+}
+
+// Destructor
+inline PerfCounters::~PerfCounters() {
+    close();
+}
+
+#ifdef __linux__
+
+// Open and start all counters which are supported
+inline bool PerfCounters::open(std::string& error) {
+    static constexpr std::uint64_t EVENT_CONFIGS[HardwareCounters::COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    close();
+    int first_errno = 0;
+    for (std::size_t i = 0; i < HardwareCounters::COUNTER_COUNT; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = EVENT_CONFIGS[i];
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = open_count == 0 ? 1 : 0; // The whole group is started by its leader
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        const int group_descriptor = open_count == 0 ? -1 : descriptors[0];
+        const int descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_descriptor, 0));
+        if (descriptor < 0) {
+            // Counter isn't supported by this CPU or hypervisor, the rest of the group can still work
+            if (first_errno == 0) {
+                first_errno = errno;
+            }
+            continue;
+        }
+        descriptors[open_count] = descriptor;
+        counters[open_count] = static_cast<EHardwareCounter>(i);
+        ++open_count;
+    }
+
+    if (open_count == 0) {
+        error = std::string("perf_event_open failed: ") + std::strerror(first_errno);
+        return false;
+    }
+    ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+// Close all counters
+inline void PerfCounters::close() noexcept {
+    // Members are closed before the leader
+    while (open_count > 0) {
+        --open_count;
+        ::close(descriptors[open_count]);
+    }
+}
+
+// Read current values
+inline HardwareCounters PerfCounters::read() const noexcept {
+    HardwareCounters result;
+    if (open_count == 0) {
+        return result;
+    }
+
+    // Layout of PERF_FORMAT_GROUP: count of values, time enabled, time running, values in the order of opening
+    std::array<std::uint64_t, 3 + HardwareCounters::COUNTER_COUNT> buffer{};
+    const ssize_t expected_size = static_cast<ssize_t>((3 + open_count) * sizeof(std::uint64_t));
+    if (::read(descriptors[0], buffer.data(), sizeof(buffer)) != expected_size || buffer[0] != open_count) {
+        return result;
+    }
+
+    const std::uint64_t time_enabled = buffer[1];
+    const std::uint64_t time_running = buffer[2];
+    if (time_running == 0) {
+        return result;
+    }
+    const double scale = static_cast<double>(time_enabled) / static_cast<double>(time_running);
+    for (std::size_t i = 0; i < open_count; ++i) {
+        const std::size_t index = static_cast<std::size_t>(counters[i]);
+        result.values[index] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + i]) * scale);
+        result.available[index] = true;
+    }
+    return result;
+}
+
+#else
+
+// Open and start all counters which are supported
+inline bool PerfCounters::open(std::string& error) {
+    error = "hardware counters are supported only on Linux";
+    return false;
+}
+
+// Close all counters
+inline void PerfCounters::close() noexcept {
+    open_count = 0;
+}
+
+// Read current values
+inline HardwareCounters PerfCounters::read() const noexcept {
+    return HardwareCounters{};
+}
+
+#endif
+
+// Check if at least one counter is open
+inline bool PerfCounters::isOpen() const noexcept {
+    return open_count > 0;
+}
@@ -0,0 +1,71 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "full_state.h"
+#include "program.h"
+#include "variables.h"
+
+// Template class for profiling program execution over many inputs
+// Hits of each program position and taken/not-taken outcomes of each jump are accumulated in per-position counters
+// Runs are stopped by step limit instead of infinite loop detection, so profiling costs little more than plain Executor
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class ProfilingExecutor {
+public:
+    using ProgramType = ProgramClass;
+    using InputVariablesType = InputVariables<N>;
+    using FullStateType = FullState<N, K, T>;
+
+    // Default count of executed instructions after which run is considered as stuck in infinite loop
+    static constexpr std::uint64_t DEFAULT_MAX_INSTRUCTIONS = 2000000;
+
+    // Constructors
+    explicit ProfilingExecutor(const ProgramType& program_arg, std::uint64_t max_instructions_arg = DEFAULT_MAX_INSTRUCTIONS);
+
+    // Access to program
+    const ProgramType& getProgram() const noexcept;
+
+    // Run program on input and accumulate counters
+    // Returns false if run was stopped by step limit
+    bool run(const InputVariablesType& input);
+
+    // Run program on all 256^N inputs and accumulate counters
+    void runAllInputs();
+
+    // Reset all counters
+    void reset();
+
+    // Access to state of the last run
+    const FullStateType& getFullState() const noexcept;
+
+    // Access to counters
+    std::uint64_t getRunCount() const noexcept;
+    std::uint64_t getStepLimitCount() const noexcept;
+    std::uint64_t getInstructionCount() const noexcept;
+    std::uint64_t getHitCount(std::size_t position) const;
+    // Jump outcomes, a jump whose target is the next position is always counted as not taken
+    std::uint64_t getTakenCount(std::size_t position) const;
+    std::uint64_t getNotTakenCount(std::size_t position) const;
+
+    // Dump program annotated with hit counts, shares of all executed instructions and jump outcomes
+    std::string dump() const;
+
+private:
+    const ProgramType* program;
+    std::uint64_t max_instructions;
+    FullStateType full_state;
+
+    // Jump flags and counters indexed by program position
+    std::vector<bool> is_jump;
+    std::vector<std::uint64_t> hits;
+    std::vector<std::uint64_t> taken;
+
+    std::uint64_t run_count = 0;
+    std::uint64_t step_limit_count = 0;
+    std::uint64_t instruction_count = 0;
+};
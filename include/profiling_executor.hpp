@@ -0,0 +1,152 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+#include "packed_instruction.hpp"
+#include "profiling_executor.h"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::ProfilingExecutor(const ProgramType& program_arg, std::uint64_t max_instructions_arg)
+    : program(&program_arg), max_instructions(max_instructions_arg),
+      is_jump(program_arg.size()), hits(program_arg.size()), taken(program_arg.size()) {
+    for (std::size_t position = 0; position < program_arg.size(); ++position) {
+        is_jump[position] = program_arg[position].encode().isJump();
+    }
+}
+
+// Access to program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::ProgramType& ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getProgram() const noexcept {
+    return *program;
+}
+
+// Run program on input and accumulate counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::run(const InputVariablesType& input) {
+    full_state = FullStateType(Variables<N, K, T>(input), 0);
+    ++run_count;
+
+    const std::size_t program_size = program->size();
+    std::uint64_t executed = 0;
+    while (full_state.instructionPointer() < program_size) {
+        if (executed == max_instructions) {
+            instruction_count += executed;
+            ++step_limit_count;
+            return false;
+        }
+        const std::size_t position = full_state.instructionPointer();
+        program->execute(full_state);
+        ++executed;
+        ++hits[position];
+        if (is_jump[position] && full_state.instructionPointer() != position + 1) {
+            ++taken[position];
+        }
+    }
+    instruction_count += executed;
+    return true;
+}
+
+// Run program on all inputs
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::runAllInputs() {
+    InputVariablesType input;
+    for (unsigned i = 0; i < N; ++i) {
+        input.values[i] = 0;
+    }
+
+    // Multi-digit counter in base 256
+    while (true) {
+        run(input);
+        unsigned pos = 0;
+        while (pos < N && input.values[pos] == 255) {
+            input.values[pos] = 0;
+            ++pos;
+        }
+        if (pos >= N) {
+            break;
+        }
+        ++input.values[pos];
+    }
+}
+
+// Reset all counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::reset() {
+    std::fill(hits.begin(), hits.end(), 0);
+    std::fill(taken.begin(), taken.end(), 0);
+    run_count = 0;
+    step_limit_count = 0;
+    instruction_count = 0;
+}
+
+// Access to state of the last run
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::FullStateType& ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getFullState() const noexcept {
+    return full_state;
+}
+
+// Access to counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getRunCount() const noexcept {
+    return run_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getStepLimitCount() const noexcept {
+    return step_limit_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getInstructionCount() const noexcept {
+    return instruction_count;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getHitCount(std::size_t position) const {
+    assert(position < hits.size());
+    return hits[position];
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getTakenCount(std::size_t position) const {
+    assert(position < taken.size());
+    return taken[position];
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::getNotTakenCount(std::size_t position) const {
+    assert(position < hits.size());
+    return is_jump[position] ? hits[position] - taken[position] : 0;
+}
+
+// Dump program annotated with counters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::string ProfilingExecutor<InstructionSet, N, K, T, ProgramClass>::dump() const {
+    std::ostringstream oss;
+
+    oss << "Runs: " << run_count << ", stopped by step limit: " << step_limit_count << "\n";
+    oss << "Instructions executed: " << instruction_count << "\n\n";
+
+    // Columns: hits, share of all executed instructions, taken and not taken outcomes of jumps, instruction
+    oss << "Program:\n";
+    oss << std::setw(14) << "hits" << std::setw(9) << "%" << std::setw(14) << "taken" << std::setw(14) << "not taken" << "   instruction\n";
+    oss << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < program->size(); ++i) {
+        const double share = instruction_count > 0 ? 100.0 * static_cast<double>(hits[i]) / static_cast<double>(instruction_count) : 0.0;
+        oss << std::setw(14) << hits[i] << std::setw(8) << share << '%';
+        if (is_jump[i]) {
+            oss << std::setw(14) << taken[i] << std::setw(14) << hits[i] - taken[i];
+        } else {
+            oss << std::setw(14) << "" << std::setw(14) << "";
+        }
+        oss << "   " << (*program)[i].dump(i) << "\n";
+    }
+
+    return oss.str();
+}
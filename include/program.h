@@ -5,16 +5,22 @@
 
 #include <cassert>
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include <variant>
 #include <vector>
 #include "full_state.h"
+#include "text_format.h"
 
 // Template class for program working with any variant type of instructions
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+// Allocator is used for instruction storage, see PmrProgram for programs placed in Arena
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator = std::allocator<InstructionSet<N, K, T>>>
 class Program {
 public:
     using InstructionSetType = InstructionSet<N, K, T>;
-    using Instructions = std::vector<InstructionSetType>;
+    using allocator_type = Allocator;
+    using Instructions = std::vector<InstructionSetType, Allocator>;
     using size_type = typename Instructions::size_type;
     using iterator = typename Instructions::iterator;
     using const_iterator = typename Instructions::const_iterator;
@@ -22,6 +28,13 @@ public:
     // Constructors
     Program() = default;
     explicit Program(size_type capacity);
+    explicit Program(const Allocator& allocator);
+    Program(size_type capacity, const Allocator& allocator);
+    Program(const Program& other) = default;
+    Program(const Program& other, const Allocator& allocator);
+    Program(Program&& other) noexcept = default;
+    Program& operator=(const Program& other) = default;
+    Program& operator=(Program&& other) = default;
 
     // Add instruction
     template<typename Instruction>
@@ -59,6 +72,13 @@ public:
     // Dump program as text representation
     std::string dump() const;
 
+    // Append text representation to output, memory is allocated only if output has to grow
+    void appendTo(std::string& output) const;
+
 private:
     Instructions instructions;
 };
+
+// Program with polymorphic allocator, it can be placed in Arena or any other memory resource
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+using PmrProgram = Program<InstructionSet, N, K, T, std::pmr::polymorphic_allocator<InstructionSet<N, K, T>>>;
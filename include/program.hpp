@@ -3,98 +3,113 @@
 
 #pragma once
 
-#include <sstream>
 #include <string>
 
 // Constructors
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline Program<InstructionSet, N, K, T>::Program(typename Program<InstructionSet, N, K, T>::size_type capacity) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline Program<InstructionSet, N, K, T, Allocator>::Program(typename Program<InstructionSet, N, K, T, Allocator>::size_type capacity) {
     instructions.reserve(capacity);
 }
 
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline Program<InstructionSet, N, K, T, Allocator>::Program(const Allocator& allocator)
+    : instructions(allocator) {
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline Program<InstructionSet, N, K, T, Allocator>::Program(size_type capacity, const Allocator& allocator)
+    : instructions(allocator) {
+    instructions.reserve(capacity);
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline Program<InstructionSet, N, K, T, Allocator>::Program(const Program& other, const Allocator& allocator)
+    : instructions(other.instructions, allocator) {
+}
+
 // Add instruction
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
 template<typename Instruction>
-inline void Program<InstructionSet, N, K, T>::add(Instruction&& inst) {
+inline void Program<InstructionSet, N, K, T, Allocator>::add(Instruction&& inst) {
     instructions.emplace_back(std::forward<Instruction>(inst));
 }
 
 // Access to instructions
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::InstructionSetType& Program<InstructionSet, N, K, T>::operator[](typename Program<InstructionSet, N, K, T>::size_type index) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::InstructionSetType& Program<InstructionSet, N, K, T, Allocator>::operator[](typename Program<InstructionSet, N, K, T, Allocator>::size_type index) {
     assert(index < instructions.size());
     return instructions[index];
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename Program<InstructionSet, N, K, T>::InstructionSetType& Program<InstructionSet, N, K, T>::operator[](typename Program<InstructionSet, N, K, T>::size_type index) const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline const typename Program<InstructionSet, N, K, T, Allocator>::InstructionSetType& Program<InstructionSet, N, K, T, Allocator>::operator[](typename Program<InstructionSet, N, K, T, Allocator>::size_type index) const {
     assert(index < instructions.size());
     return instructions[index];
 }
 
 // Program size
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::size_type Program<InstructionSet, N, K, T>::size() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::size_type Program<InstructionSet, N, K, T, Allocator>::size() const noexcept {
     return instructions.size();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool Program<InstructionSet, N, K, T>::empty() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline bool Program<InstructionSet, N, K, T, Allocator>::empty() const noexcept {
     return instructions.empty();
 }
 
 // Iterators
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::iterator Program<InstructionSet, N, K, T>::begin() noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::iterator Program<InstructionSet, N, K, T, Allocator>::begin() noexcept {
     return instructions.begin();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::iterator Program<InstructionSet, N, K, T>::end() noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::iterator Program<InstructionSet, N, K, T, Allocator>::end() noexcept {
     return instructions.end();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::const_iterator Program<InstructionSet, N, K, T>::begin() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::const_iterator Program<InstructionSet, N, K, T, Allocator>::begin() const noexcept {
     return instructions.begin();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::const_iterator Program<InstructionSet, N, K, T>::end() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::const_iterator Program<InstructionSet, N, K, T, Allocator>::end() const noexcept {
     return instructions.end();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::const_iterator Program<InstructionSet, N, K, T>::cbegin() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::const_iterator Program<InstructionSet, N, K, T, Allocator>::cbegin() const noexcept {
     return instructions.cbegin();
 }
 
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline typename Program<InstructionSet, N, K, T>::const_iterator Program<InstructionSet, N, K, T>::cend() const noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline typename Program<InstructionSet, N, K, T, Allocator>::const_iterator Program<InstructionSet, N, K, T, Allocator>::cend() const noexcept {
     return instructions.cend();
 }
 
 // Clear
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void Program<InstructionSet, N, K, T>::clear() noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline void Program<InstructionSet, N, K, T, Allocator>::clear() noexcept {
     instructions.clear();
 }
 
 // Reserve memory
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void Program<InstructionSet, N, K, T>::reserve(typename Program<InstructionSet, N, K, T>::size_type capacity) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline void Program<InstructionSet, N, K, T, Allocator>::reserve(typename Program<InstructionSet, N, K, T, Allocator>::size_type capacity) {
     instructions.reserve(capacity);
 }
 
 // Swap
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void Program<InstructionSet, N, K, T>::swap(Program& other) noexcept {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline void Program<InstructionSet, N, K, T, Allocator>::swap(Program& other) noexcept {
     instructions.swap(other.instructions);
 }
 
 // Execute current instruction
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool Program<InstructionSet, N, K, T>::execute(FullState<N, K, T>& full_state) const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline bool Program<InstructionSet, N, K, T, Allocator>::execute(FullState<N, K, T>& full_state) const {
     if (full_state.instructionPointer() >= instructions.size()) {
         return false;
     }
@@ -107,11 +122,20 @@ inline bool Program<InstructionSet, N, K, T>::execute(FullState<N, K, T>& full_s
 }
 
 // Dump program as text representation
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline std::string Program<InstructionSet, N, K, T>::dump() const {
-    std::ostringstream oss;
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline std::string Program<InstructionSet, N, K, T, Allocator>::dump() const {
+    std::string result;
+    appendTo(result);
+    return result;
+}
+
+// Append text representation
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename Allocator>
+inline void Program<InstructionSet, N, K, T, Allocator>::appendTo(std::string& output) const {
+    char buffer[MAX_INSTRUCTION_TEXT_SIZE + 1];
     for (size_type i = 0; i < instructions.size(); ++i) {
-        oss << instructions[i].dump(i) << "\n";
+        char* end = instructions[i].appendTo(buffer, static_cast<unsigned>(i));
+        *end++ = '\n';
+        output.append(buffer, end);
     }
-    return oss.str();
 }
@@ -0,0 +1,72 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "packed_instruction.h"
+
+// Write value as byte_count bytes in little-endian order
+void writeLittleEndian(std::uint64_t value, unsigned byte_count, std::uint8_t* data) noexcept;
+
+// Read byte_count bytes in little-endian order
+std::uint64_t readLittleEndian(const std::uint8_t* data, unsigned byte_count) noexcept;
+
+// Header of serialized program
+// Layout, all fields are little-endian:
+// * instruction set - 1 byte, EInstructionSetId
+// * N, K, T         - 1 byte each
+// * length          - 4 bytes, count of instructions
+// Header is followed by length packed instructions, 4 bytes each
+struct SerializedProgramHeader {
+    static constexpr std::size_t SIZE = 8;
+    static constexpr std::size_t INSTRUCTION_SIZE = 4;
+
+    EInstructionSetId instruction_set = EInstructionSetId::B0;
+    std::uint8_t n = 0;
+    std::uint8_t k = 0;
+    std::uint8_t t = 0;
+    std::uint32_t length = 0;
+
+    // Size of header and instructions
+    std::size_t getSerializedSize() const noexcept;
+
+    // Write header into SIZE bytes
+    void write(std::uint8_t* data) const noexcept;
+
+    // Read header from SIZE bytes
+    static SerializedProgramHeader read(const std::uint8_t* data) noexcept;
+};
+
+// Compact binary form of programs, it doesn't depend on host byte order
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+class ProgramSerializer {
+public:
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+
+    // Header of program of the given size
+    static SerializedProgramHeader makeHeader(std::size_t program_size) noexcept;
+
+    // Check if header matches instruction set and N, K, T of this serializer
+    static bool isCompatible(const SerializedProgramHeader& header, std::string& error);
+
+    // Append serialized program to buffer, instruction set must provide encode()
+    template<typename ProgramClass>
+    static void serialize(const ProgramClass& program, std::vector<std::uint8_t>& buffer);
+
+    // 64-bit FNV-1a hash of serialized program, it covers instruction set, N, K, T and all instructions
+    template<typename ProgramClass>
+    static std::uint64_t getHash(const ProgramClass& program);
+
+    // Read program from the beginning of data, consumed receives count of read bytes
+    // Returns false if data is truncated, doesn't match this serializer or contains instruction outside of instruction set
+    template<typename ProgramClass>
+    static bool deserialize(const std::uint8_t* data, std::size_t size, ProgramClass& program, std::size_t& consumed, std::string& error);
+
+    // Decode instructions which follow compatible header, data must contain header.length instructions
+    template<typename ProgramClass>
+    static bool decodeInstructions(const SerializedProgramHeader& header, const std::uint8_t* data, ProgramClass& program, std::string& error);
+};
@@ -0,0 +1,157 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include "packed_instruction.hpp"
+#include "program_serialization.h"
+
+// Write value in little-endian order
+inline void writeLittleEndian(std::uint64_t value, unsigned byte_count, std::uint8_t* data) noexcept {
+    for (unsigned i = 0; i < byte_count; ++i) {
+        data[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+// Read value in little-endian order
+inline std::uint64_t readLittleEndian(const std::uint8_t* data, unsigned byte_count) noexcept {
+    std::uint64_t value = 0;
+    for (unsigned i = 0; i < byte_count; ++i) {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Size of header and instructions
+inline std::size_t SerializedProgramHeader::getSerializedSize() const noexcept {
+    return SIZE + static_cast<std::size_t>(length) * INSTRUCTION_SIZE;
+}
+
+// Write header
+inline void SerializedProgramHeader::write(std::uint8_t* data) const noexcept {
+    data[0] = static_cast<std::uint8_t>(instruction_set);
+    data[1] = n;
+    data[2] = k;
+    data[3] = t;
+    writeLittleEndian(length, 4, data + 4);
+}
+
+// Read header
+inline SerializedProgramHeader SerializedProgramHeader::read(const std::uint8_t* data) noexcept {
+    SerializedProgramHeader header;
+    header.instruction_set = static_cast<EInstructionSetId>(data[0]);
+    header.n = data[1];
+    header.k = data[2];
+    header.t = data[3];
+    header.length = static_cast<std::uint32_t>(readLittleEndian(data + 4, 4));
+    return header;
+}
+
+// Header of program of the given size
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline SerializedProgramHeader ProgramSerializer<InstructionSet, N, K, T>::makeHeader(std::size_t program_size) noexcept {
+    SerializedProgramHeader header;
+    header.instruction_set = InstructionSet<N, K, T>::ID;
+    header.n = static_cast<std::uint8_t>(N);
+    header.k = static_cast<std::uint8_t>(K);
+    header.t = static_cast<std::uint8_t>(T);
+    header.length = static_cast<std::uint32_t>(program_size);
+    return header;
+}
+
+// Check if header matches this serializer
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ProgramSerializer<InstructionSet, N, K, T>::isCompatible(const SerializedProgramHeader& header, std::string& error) {
+    if (header.instruction_set != InstructionSet<N, K, T>::ID) {
+        error = "Instruction set mismatch: " + std::to_string(static_cast<unsigned>(header.instruction_set)) +
+                ", expected " + std::to_string(static_cast<unsigned>(InstructionSet<N, K, T>::ID));
+        return false;
+    }
+    if (header.n != N || header.k != K || header.t != T) {
+        error = "Variable count mismatch: N=" + std::to_string(header.n) + " K=" + std::to_string(header.k) + " T=" + std::to_string(header.t) +
+                ", expected N=" + std::to_string(N) + " K=" + std::to_string(K) + " T=" + std::to_string(T);
+        return false;
+    }
+    return true;
+}
+
+// Append serialized program to buffer
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline void ProgramSerializer<InstructionSet, N, K, T>::serialize(const ProgramClass& program, std::vector<std::uint8_t>& buffer) {
+    const SerializedProgramHeader header = makeHeader(program.size());
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + header.getSerializedSize());
+
+    std::uint8_t* data = buffer.data() + offset;
+    header.write(data);
+    data += SerializedProgramHeader::SIZE;
+    for (const auto& instruction : program) {
+        writeLittleEndian(instruction.encode().word, 4, data);
+        data += SerializedProgramHeader::INSTRUCTION_SIZE;
+    }
+}
+
+// Hash of serialized program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline std::uint64_t ProgramSerializer<InstructionSet, N, K, T>::getHash(const ProgramClass& program) {
+    std::vector<std::uint8_t> buffer;
+    serialize(program, buffer);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const std::uint8_t byte : buffer) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Read program from the beginning of data
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool ProgramSerializer<InstructionSet, N, K, T>::deserialize(const std::uint8_t* data, std::size_t size, ProgramClass& program, std::size_t& consumed, std::string& error) {
+    consumed = 0;
+    if (size < SerializedProgramHeader::SIZE) {
+        error = "Truncated program header";
+        return false;
+    }
+    const SerializedProgramHeader header = SerializedProgramHeader::read(data);
+    if (!isCompatible(header, error)) {
+        return false;
+    }
+    if (size < header.getSerializedSize()) {
+        error = "Truncated program of " + std::to_string(header.length) + " instructions";
+        return false;
+    }
+    if (!decodeInstructions(header, data + SerializedProgramHeader::SIZE, program, error)) {
+        return false;
+    }
+    consumed = header.getSerializedSize();
+    return true;
+}
+
+// Decode instructions which follow compatible header
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool ProgramSerializer<InstructionSet, N, K, T>::decodeInstructions(const SerializedProgramHeader& header, const std::uint8_t* data, ProgramClass& program, std::string& error) {
+    constexpr unsigned VARIABLE_COUNT = N + K + T;
+
+    program.clear();
+    program.reserve(header.length);
+    for (std::uint32_t i = 0; i < header.length; ++i) {
+        PackedInstructionType packed;
+        packed.word = static_cast<std::uint32_t>(readLittleEndian(data + static_cast<std::size_t>(i) * SerializedProgramHeader::INSTRUCTION_SIZE, 4));
+        // decode() asserts on foreign opcodes, so they are rejected here
+        if (!InstructionSet<N, K, T>::isSupported(packed.getOpcode())) {
+            error = "Instruction " + std::to_string(i) + " has unsupported opcode " + std::to_string(static_cast<unsigned>(packed.getOpcode()));
+            return false;
+        }
+        if (packed.getOperand1() >= VARIABLE_COUNT || packed.getOperand2() >= VARIABLE_COUNT ||
+            packed.getArrayType() > PackedInstructionType::EAddressType::Temp) {
+            error = "Instruction " + std::to_string(i) + " has operand out of range";
+            return false;
+        }
+        program.add(InstructionSet<N, K, T>::decode(packed));
+    }
+    return true;
+}
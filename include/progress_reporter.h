@@ -0,0 +1,82 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include "async_writer.h"
+#include "search_stats.h"
+
+// Reporter of search progress as JSON-lines events
+// Periodic progress events are throttled by wall-clock interval, so the search loop only reads the clock
+// Events: "size_start", "progress", "best", "size_complete"
+class ProgressReporter {
+public:
+    // Receiver of one event line, the line ends with '\n'
+    using SinkType = std::function<void(const std::string& line)>;
+
+    // Default interval between progress events
+    static constexpr double DEFAULT_INTERVAL_SECONDS = 1.0;
+
+    // Constructors
+    // Events go to std::cout by default
+    ProgressReporter();
+
+    // Send events to sink, empty sink disables reporting
+    void setSink(SinkType sink_arg);
+
+    // Write events to file instead of sink, returns false if file can't be opened
+    // Events are written by the writer thread of async_writer if it isn't null, async_writer must outlive the reporter
+    bool openStream(const std::string& file_name, AsyncWriter* async_writer = nullptr);
+
+    // Stop writing to file, events go to sink again
+    void closeStream();
+
+    // Checkpoint: write events to file, waits for the writer thread
+    void flush();
+
+    // Check if writing events to file failed, e.g. disk is full, it is exact after flush() or closeStream()
+    bool hasWriteError() const noexcept;
+
+    // Interval between progress events
+    void setInterval(double seconds) noexcept;
+    double getInterval() const noexcept;
+
+    // Check if events go anywhere
+    bool isEnabled() const noexcept;
+
+    // Start search of programs of the given size, space_size is count of candidates of this size
+    // best_total_steps is cost of the best program found so far, it is the reference program before the first size
+    void startSize(unsigned program_size_arg, std::uint64_t space_size_arg, std::uint64_t best_total_steps);
+
+    // Emit progress event if interval has elapsed since the previous one
+    // counters are statistics of the current program size, rank is taken from candidates_generated
+    void update(const SearchCounters& counters, std::uint64_t best_total_steps);
+
+    // Emit event about better program, it is never throttled
+    void reportBest(const SearchCounters& counters, std::uint64_t best_total_steps);
+
+    // Emit event about finished program size
+    void finishSize(const SearchCounters& counters, std::uint64_t best_total_steps);
+
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    SinkType sink;
+    std::ofstream stream;
+    AsyncWriter* stream_writer = nullptr;
+    AsyncWriter::ChannelId stream_channel = 0;
+    bool write_failed = false;
+    ClockType::duration interval;
+    ClockType::time_point size_start;
+    ClockType::time_point next_report;
+    unsigned program_size = 0;
+    std::uint64_t space_size = 0;
+
+    // Format event with current counters and pass it to file or sink
+    void emit(const char* event, const SearchCounters& counters, std::uint64_t best_total_steps, ClockType::time_point now);
+};
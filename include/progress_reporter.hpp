@@ -0,0 +1,151 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include "async_writer.hpp"
+#include "progress_reporter.h"
+
+// Constructors
+inline ProgressReporter::ProgressReporter()
+    : sink([](const std::string& line) { std::cout << line << std::flush; }) {
+    setInterval(DEFAULT_INTERVAL_SECONDS);
+}
+
+// Send events to sink
+inline void ProgressReporter::setSink(SinkType sink_arg) {
+    sink = std::move(sink_arg);
+}
+
+// Write events to file instead of sink
+inline bool ProgressReporter::openStream(const std::string& file_name, AsyncWriter* async_writer) {
+    closeStream();
+    write_failed = false;
+    stream.open(file_name, std::ios::out | std::ios::trunc);
+    if (!stream.is_open()) {
+        return false;
+    }
+    if (async_writer != nullptr) {
+        stream_writer = async_writer;
+        stream_channel = stream_writer->addChannel(std::move(stream));
+    }
+    return true;
+}
+
+// Stop writing to file
+inline void ProgressReporter::closeStream() {
+    if (stream_writer != nullptr) {
+        stream_writer->closeChannel(stream_channel);
+        write_failed = write_failed || stream_writer->hasFailed(stream_channel);
+        stream_writer = nullptr;
+    }
+    if (stream.is_open()) {
+        stream.close();
+        write_failed = write_failed || !stream;
+    }
+}
+
+// Checkpoint
+inline void ProgressReporter::flush() {
+    if (stream_writer != nullptr) {
+        stream_writer->flush();
+        write_failed = write_failed || stream_writer->hasFailed(stream_channel);
+    } else if (stream.is_open()) {
+        write_failed = write_failed || !stream;
+    }
+}
+
+// Check if writing to file failed
+inline bool ProgressReporter::hasWriteError() const noexcept {
+    return write_failed;
+}
+
+// Interval between progress events
+inline void ProgressReporter::setInterval(double seconds) noexcept {
+    interval = std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(seconds));
+}
+
+inline double ProgressReporter::getInterval() const noexcept {
+    return std::chrono::duration<double>(interval).count();
+}
+
+// Check if events go anywhere
+inline bool ProgressReporter::isEnabled() const noexcept {
+    return stream_writer != nullptr || stream.is_open() || static_cast<bool>(sink);
+}
+
+// Start search of programs of the given size
+inline void ProgressReporter::startSize(unsigned program_size_arg, std::uint64_t space_size_arg, std::uint64_t best_total_steps) {
+    program_size = program_size_arg;
+    space_size = space_size_arg;
+    size_start = ClockType::now();
+    next_report = size_start + interval;
+    if (isEnabled()) {
+        emit("size_start", SearchCounters{}, best_total_steps, size_start);
+    }
+}
+
+// Emit progress event if interval has elapsed
+inline void ProgressReporter::update(const SearchCounters& counters, std::uint64_t best_total_steps) {
+    const ClockType::time_point now = ClockType::now();
+    if (now < next_report || !isEnabled()) {
+        return;
+    }
+    next_report = now + interval;
+    emit("progress", counters, best_total_steps, now);
+}
+
+// Emit event about better program
+inline void ProgressReporter::reportBest(const SearchCounters& counters, std::uint64_t best_total_steps) {
+    if (isEnabled()) {
+        emit("best", counters, best_total_steps, ClockType::now());
+    }
+}
+
+// Emit event about finished program size
+inline void ProgressReporter::finishSize(const SearchCounters& counters, std::uint64_t best_total_steps) {
+    if (isEnabled()) {
+        emit("size_complete", counters, best_total_steps, ClockType::now());
+    }
+}
+
+// Format event and pass it to file or sink
+inline void ProgressReporter::emit(const char* event, const SearchCounters& counters, std::uint64_t best_total_steps, ClockType::time_point now) {
+    const double elapsed_seconds = std::chrono::duration<double>(now - size_start).count();
+    const std::uint64_t rank = counters.candidates_generated;
+    const double candidates_per_s = elapsed_seconds > 0.0 ? static_cast<double>(rank) / elapsed_seconds : 0.0;
+    const double instructions_per_s = elapsed_seconds > 0.0 ? static_cast<double>(counters.instructions_executed) / elapsed_seconds : 0.0;
+    const double remaining = rank < space_size ? static_cast<double>(space_size - rank) : 0.0;
+
+    std::ostringstream oss;
+    oss << "{\"event\":\"" << event << "\""
+        << ",\"program_size\":" << program_size
+        << ",\"rank\":" << rank
+        << ",\"space_size\":" << space_size
+        << ",\"fraction\":" << (space_size > 0 ? static_cast<double>(rank) / static_cast<double>(space_size) : 0.0)
+        << ",\"elapsed_s\":" << elapsed_seconds
+        << ",\"candidates_per_s\":" << candidates_per_s
+        << ",\"instructions_per_s\":" << instructions_per_s
+        << ",\"pruned\":" << counters.getPrunedCount()
+        << ",\"rejected\":" << counters.getRejectedCount()
+        << ",\"valid\":" << counters.candidates_valid
+        << ",\"best_total_steps\":" << best_total_steps;
+    // ETA is unknown until some candidates are done
+    if (candidates_per_s > 0.0) {
+        oss << ",\"eta_s\":" << remaining / candidates_per_s;
+    } else {
+        oss << ",\"eta_s\":null";
+    }
+    oss << "}\n";
+
+    if (stream_writer != nullptr) {
+        stream_writer->write(stream_channel, oss.str());
+    } else if (stream.is_open()) {
+        stream << oss.str() << std::flush;
+    } else if (sink) {
+        sink(oss.str());
+    }
+}
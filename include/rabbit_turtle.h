@@ -3,22 +3,30 @@
 
 #pragma once
 
+#include <cstdint>
+#include "cost_model.h"
 #include "executor.h"
 #include "program.h"
 #include "variables.h"
 
 // Template class for rabbit executor with constant reference to program
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
 class RabbitTurtle {
 public:
-    using ProgramType = Program<InstructionSet, N, K, T>;
+    using ProgramType = ProgramClass;
     using InputVariablesType = InputVariables<N>;
     using OutputVariablesType = OutputVariables<K>;
-    using ExecutorType = Executor<InstructionSet, N, K, T>;
+    using ExecutorType = Executor<InstructionSet, N, K, T, ProgramClass>;
 
     // Constructors
     explicit RabbitTurtle(const ProgramType& program_arg, const InputVariablesType& input_arg);
 
+    // Restart execution of the same program on new input
+    void reset(const InputVariablesType& input_arg);
+
+    // Restart execution of another program on new input
+    void reset(const ProgramType& program_arg, const InputVariablesType& input_arg);
+
     // Access to program
     const ProgramType& getProgram() const;
 
@@ -38,6 +46,10 @@ public:
     // Returns false if program is finished, true otherwise
     bool execute();
 
+    // Execute one iteration and add costs of instructions executed by rabbit to cost
+    // Returns false if program is finished, true otherwise
+    bool execute(const CostModel& cost_model, std::uint64_t& cost);
+
     // Execute one iteration and dump rabbit executor state after each rabbit step
     // Returns false if program is finished, true otherwise
     bool executeDump(std::string& dump_after_first_step, std::string& dump_after_second_step);
@@ -46,11 +58,14 @@ public:
     bool isInfiniteLoopDetected() const;
 
 private:
-    const ProgramType& program;
-    const InputVariablesType& input;
+    const ProgramType* program;
+    InputVariablesType input;
     OutputVariablesType output;
     ExecutorType rabbit;
     ExecutorType turtle;
     bool infinite_loop_detected = false;
+
+    // Rabbit makes one step and adds cost of the executed instruction
+    bool stepRabbit(const CostModel& cost_model, std::uint64_t& cost);
 };
 
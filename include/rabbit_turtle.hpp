@@ -4,32 +4,49 @@
 #pragma once
 
 // Constructors
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline RabbitTurtle<InstructionSet, N, K, T>::RabbitTurtle(const typename RabbitTurtle<InstructionSet, N, K, T>::ProgramType& program_arg, const typename RabbitTurtle<InstructionSet, N, K, T>::InputVariablesType& input_arg)
-    : program(program_arg), input(input_arg), rabbit(program_arg, input_arg), turtle(program_arg, input_arg) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::RabbitTurtle(const typename RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::ProgramType& program_arg, const typename RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::InputVariablesType& input_arg)
+    : program(&program_arg), input(input_arg), rabbit(program_arg, input_arg), turtle(program_arg, input_arg) {
+}
+
+// Restart execution of the same program on new input
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::reset(const InputVariablesType& input_arg) {
+    input = input_arg;
+    start();
+}
+
+// Restart execution of another program on new input
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::reset(const ProgramType& program_arg, const InputVariablesType& input_arg) {
+    program = &program_arg;
+    rabbit.reset(program_arg, input_arg);
+    turtle.reset(program_arg, input_arg);
+    input = input_arg;
+    infinite_loop_detected = false;
 }
 
 // Access to program
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename RabbitTurtle<InstructionSet, N, K, T>::ProgramType& RabbitTurtle<InstructionSet, N, K, T>::getProgram() const {
-    return program;
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::ProgramType& RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::getProgram() const {
+    return *program;
 }
 
 // Access to input variables
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename RabbitTurtle<InstructionSet, N, K, T>::InputVariablesType& RabbitTurtle<InstructionSet, N, K, T>::getInput() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::InputVariablesType& RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::getInput() const {
     return input;
 }
 
 // Access to output variables
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline const typename RabbitTurtle<InstructionSet, N, K, T>::OutputVariablesType& RabbitTurtle<InstructionSet, N, K, T>::getOutput() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const typename RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::OutputVariablesType& RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::getOutput() const {
     return output;
 }
 
 // Start execution
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline void RabbitTurtle<InstructionSet, N, K, T>::start() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::start() {
     // Create variables with input from input and zero-initialized output and temp
     Variables<N, K, T> variables(input);
 
@@ -45,15 +62,15 @@ inline void RabbitTurtle<InstructionSet, N, K, T>::start() {
 }
 
 // Start execution and dump rabbit executor state
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline std::string RabbitTurtle<InstructionSet, N, K, T>::startDump() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::string RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::startDump() {
     start();
     return rabbit.dump();
 }
 
 // Execute one iteration: rabbit makes 2 steps, turtle makes 1 step
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool RabbitTurtle<InstructionSet, N, K, T>::execute() {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::execute() {
     // Rabbit makes first step
     if (!rabbit.execute()) {
         // Program finished - copy output variables from rabbit
@@ -83,9 +100,45 @@ inline bool RabbitTurtle<InstructionSet, N, K, T>::execute() {
     return true; // Continue execution
 }
 
+// Execute one iteration and add costs of instructions executed by rabbit
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::execute(const CostModel& cost_model, std::uint64_t& cost) {
+    // Rabbit makes two steps
+    if (!stepRabbit(cost_model, cost) || !stepRabbit(cost_model, cost)) {
+        output = rabbit.getFullState().getVariables().output;
+        return false; // Program finished
+    }
+
+    // Turtle makes one step
+    if (!turtle.execute()) {
+        output = turtle.getFullState().getVariables().output;
+        return false; // Program finished
+    }
+
+    // Compare states: if rabbit and turtle are at the same state, infinite loop detected
+    if (rabbit.getFullState().isSame(turtle.getFullState())) {
+        infinite_loop_detected = true;
+    }
+
+    return true; // Continue execution
+}
+
+// Rabbit makes one step and adds cost of the executed instruction
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::stepRabbit(const CostModel& cost_model, std::uint64_t& cost) {
+    const std::size_t position = rabbit.getFullState().instructionPointer();
+    if (position >= program->size()) {
+        return false;
+    }
+    const bool running = rabbit.execute();
+    const CostModel::Cost& instruction_cost = cost_model.getCost((*program)[position]);
+    cost += rabbit.getFullState().instructionPointer() == position + 1 ? instruction_cost.not_taken : instruction_cost.taken;
+    return running;
+}
+
 // Execute one iteration and dump rabbit executor state after each rabbit step
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool RabbitTurtle<InstructionSet, N, K, T>::executeDump(std::string& dump_after_first_step, std::string& dump_after_second_step) {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::executeDump(std::string& dump_after_first_step, std::string& dump_after_second_step) {
     // Rabbit makes first step
     if (!rabbit.execute()) {
         // Program finished - copy output variables from rabbit
@@ -121,8 +174,8 @@ inline bool RabbitTurtle<InstructionSet, N, K, T>::executeDump(std::string& dump
 }
 
 // Check if infinite loop was detected
-template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
-inline bool RabbitTurtle<InstructionSet, N, K, T>::isInfiniteLoopDetected() const {
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool RabbitTurtle<InstructionSet, N, K, T, ProgramClass>::isInfiniteLoopDetected() const {
     return infinite_loop_detected;
 }
 
@@ -0,0 +1,127 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "arena.h"
+#include "async_writer.h"
+#include "program.h"
+#include "result_store.h"
+
+// Template class which collects valid programs found by the search
+// Memory use is bounded: only max_kept programs with the lowest cost are retained, all others are only counted
+// Every valid program can optionally be streamed to a text file or appended to a binary result store as it is found
+// With AsyncWriter both are written by its writer thread, text is formatted there from serialized records
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class ResultSink {
+public:
+    using ProgramType = ProgramClass;
+
+    // Default count of retained programs
+    static constexpr std::size_t DEFAULT_MAX_KEPT = 16;
+
+    enum class EMode {
+        TopK,     // Retain max_kept programs with the lowest cost
+        CountOnly // Retain nothing, only count valid programs
+    };
+
+    // Retained program with its cost
+    struct Entry {
+        ProgramType program;
+        std::uint64_t total_steps = 0;
+        std::uint64_t sequence_number = 0; // Order in which program was found, keeps ties stable
+    };
+
+    // Constructors
+    // Retained entries are allocated from resource, it must outlive the sink and should be able to reuse freed memory
+    explicit ResultSink(EMode mode_arg = EMode::TopK, std::size_t max_kept_arg = DEFAULT_MAX_KEPT,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Name of cost printed with every program, e.g. "max cost", "total steps" by default
+    // Set it before openStream(), the writer thread of async_writer keeps the name the stream was opened with
+    void setCostName(const std::string& cost_name_arg);
+    const std::string& getCostName() const noexcept;
+
+    // Stream every valid program to file, returns false if file can't be opened
+    // Programs are formatted and written by the writer thread of async_writer if it isn't null, async_writer must outlive the sink
+    bool openStream(const std::string& file_name, AsyncWriter* async_writer = nullptr);
+
+    // Stop streaming to file
+    void closeStream();
+
+    // Append every valid program to binary result store, returns false and sets error if store can't be opened
+    bool openStore(const std::string& file_name, std::string& error, AsyncWriter* async_writer = nullptr);
+
+    // Stop appending to result store
+    void closeStore();
+
+    // Checkpoint: write streamed and stored programs to files, waits for the writer thread
+    void flush();
+
+    // Check if streaming or storing programs failed, e.g. disk is full, it is exact after flush(), closeStream() and closeStore()
+    bool hasWriteError() const noexcept;
+
+    // Add valid program with its cost
+    void add(const ProgramType& program, std::uint64_t total_steps);
+
+    // Access to sink parameters
+    EMode getMode() const noexcept;
+    std::size_t getMaxKept() const noexcept;
+
+    // Count of valid programs added to sink
+    // Search doesn't add valid programs rejected by the cost bound (see getCostBound()), so in TopK mode
+    // without stream or store it counts only valid programs not rejected by the cost bound
+    std::uint64_t getCount() const noexcept;
+
+    // Count of retained programs
+    std::size_t getKeptCount() const noexcept;
+
+    // Programs of this or higher cost can't change the sink except the count, so they needn't be verified to the end
+    // Returns max value if every valid program matters: nothing is retained yet in full, or programs are streamed or stored
+    std::uint64_t getCostBound() const noexcept;
+
+    // Retained programs sorted by cost, programs of equal cost are in the order they were found
+    std::vector<Entry> getSorted() const;
+
+    // Dump retained programs as text representation
+    std::string dump() const;
+
+private:
+    EMode mode;
+    std::size_t max_kept;
+    std::uint64_t count = 0;
+    std::string cost_name = "total steps";
+
+    // Max-heap by cost, the worst retained program is on top
+    std::pmr::vector<Entry> kept;
+    // Size of total steps and sequence number in front of serialized program passed to stream_writer
+    static constexpr std::size_t RECORD_HEADER_SIZE = 16;
+
+    std::ofstream stream;
+    AsyncWriter* stream_writer = nullptr;
+    AsyncWriter::ChannelId stream_channel = 0;
+    bool stream_failed = false;
+    std::vector<std::uint8_t> record; // Serialized program passed to stream_writer
+    std::string text;                 // Text of program written to stream
+    ResultStoreWriter<InstructionSet, N, K, T> store;
+
+    // Check if programs are streamed to text file
+    bool isStreaming() const noexcept;
+
+    // Format serialized records as text, runs on the writer thread
+    static void formatRecords(const std::string& cost_name_arg, const std::uint8_t* data, std::size_t size, std::string& output);
+
+    // Append text of program with its cost, the same for stream and dump()
+    template<typename AnyProgram>
+    static void appendEntry(const std::string& cost_name_arg, const AnyProgram& program, std::uint64_t total_steps, std::uint64_t sequence_number,
+                            std::string& output);
+
+    // Order by cost, then by order found; as heap comparator it keeps the worst retained program on top
+    static bool isBetter(const Entry& entry1, const Entry& entry2) noexcept;
+};
@@ -0,0 +1,238 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include "arena.hpp"
+#include "async_writer.hpp"
+#include "program.hpp"
+#include "program_serialization.hpp"
+#include "result_store.hpp"
+#include "text_format.hpp"
+#include "result_sink.h"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline ResultSink<InstructionSet, N, K, T, ProgramClass>::ResultSink(EMode mode_arg, std::size_t max_kept_arg, std::pmr::memory_resource* resource)
+    : mode(mode_arg), max_kept(mode_arg == EMode::TopK ? max_kept_arg : 0), kept(resource) {
+    kept.reserve(max_kept);
+}
+
+// Name of cost printed with every program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::setCostName(const std::string& cost_name_arg) {
+    cost_name = cost_name_arg;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline const std::string& ResultSink<InstructionSet, N, K, T, ProgramClass>::getCostName() const noexcept {
+    return cost_name;
+}
+
+// Stream every valid program to file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ResultSink<InstructionSet, N, K, T, ProgramClass>::openStream(const std::string& file_name, AsyncWriter* async_writer) {
+    closeStream();
+    stream_failed = false;
+    stream.open(file_name, std::ios::out | std::ios::trunc);
+    if (!stream.is_open()) {
+        return false;
+    }
+    if (async_writer != nullptr) {
+        stream_writer = async_writer;
+        stream_channel = stream_writer->addChannel(std::move(stream), [name = cost_name](const std::uint8_t* data, std::size_t size, std::string& output) {
+            formatRecords(name, data, size, output);
+        });
+    }
+    return true;
+}
+
+// Stop streaming to file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::closeStream() {
+    if (stream_writer != nullptr) {
+        stream_writer->closeChannel(stream_channel);
+        stream_failed = stream_failed || stream_writer->hasFailed(stream_channel);
+        stream_writer = nullptr;
+    }
+    if (stream.is_open()) {
+        stream.close();
+        stream_failed = stream_failed || !stream;
+    }
+}
+
+// Append every valid program to binary result store
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ResultSink<InstructionSet, N, K, T, ProgramClass>::openStore(const std::string& file_name, std::string& error, AsyncWriter* async_writer) {
+    return store.open(file_name, error, async_writer);
+}
+
+// Stop appending to result store
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::closeStore() {
+    store.close();
+}
+
+// Checkpoint
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::flush() {
+    if (stream_writer != nullptr) {
+        stream_writer->flush();
+        stream_failed = stream_failed || stream_writer->hasFailed(stream_channel);
+    } else if (stream.is_open()) {
+        stream.flush();
+        stream_failed = stream_failed || !stream;
+    }
+    if (store.isOpen()) {
+        store.flush();
+    }
+}
+
+// Check if streaming or storing programs failed
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ResultSink<InstructionSet, N, K, T, ProgramClass>::hasWriteError() const noexcept {
+    return stream_failed || store.hasWriteError();
+}
+
+// Add valid program with its cost
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::add(const ProgramType& program, std::uint64_t total_steps) {
+    const std::uint64_t sequence_number = count++;
+
+    if (stream_writer != nullptr) {
+        record.resize(RECORD_HEADER_SIZE);
+        writeLittleEndian(total_steps, 8, record.data());
+        writeLittleEndian(sequence_number, 8, record.data() + 8);
+        ProgramSerializer<InstructionSet, N, K, T>::serialize(program, record);
+        stream_writer->write(stream_channel, record.data(), record.size());
+    } else if (stream.is_open()) {
+        text.clear();
+        appendEntry(cost_name, program, total_steps, sequence_number, text);
+        stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    if (store.isOpen()) {
+        store.append(program, total_steps);
+    }
+
+    if (max_kept == 0) {
+        return;
+    }
+    if (kept.size() < max_kept) {
+        kept.push_back(Entry{makeWithResource<ProgramType>(kept.get_allocator().resource(), program), total_steps, sequence_number});
+        std::push_heap(kept.begin(), kept.end(), isBetter);
+        return;
+    }
+    // Later found program of equal cost never replaces the retained one
+    if (total_steps < kept.front().total_steps) {
+        std::pop_heap(kept.begin(), kept.end(), isBetter);
+        kept.back() = Entry{makeWithResource<ProgramType>(kept.get_allocator().resource(), program), total_steps, sequence_number};
+        std::push_heap(kept.begin(), kept.end(), isBetter);
+    }
+}
+
+// Access to sink parameters
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline typename ResultSink<InstructionSet, N, K, T, ProgramClass>::EMode ResultSink<InstructionSet, N, K, T, ProgramClass>::getMode() const noexcept {
+    return mode;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t ResultSink<InstructionSet, N, K, T, ProgramClass>::getMaxKept() const noexcept {
+    return max_kept;
+}
+
+// Count of all valid programs added to sink
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ResultSink<InstructionSet, N, K, T, ProgramClass>::getCount() const noexcept {
+    return count;
+}
+
+// Count of retained programs
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::size_t ResultSink<InstructionSet, N, K, T, ProgramClass>::getKeptCount() const noexcept {
+    return kept.size();
+}
+
+// Cost from which programs can't change the sink
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::uint64_t ResultSink<InstructionSet, N, K, T, ProgramClass>::getCostBound() const noexcept {
+    if (isStreaming() || store.isOpen() || max_kept == 0 || kept.size() < max_kept) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return kept.front().total_steps;
+}
+
+// Retained programs sorted by cost
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::vector<typename ResultSink<InstructionSet, N, K, T, ProgramClass>::Entry> ResultSink<InstructionSet, N, K, T, ProgramClass>::getSorted() const {
+    std::vector<Entry> sorted(kept.begin(), kept.end());
+    std::sort(sorted.begin(), sorted.end(), isBetter);
+    return sorted;
+}
+
+// Dump retained programs as text representation
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline std::string ResultSink<InstructionSet, N, K, T, ProgramClass>::dump() const {
+    std::string result;
+    for (const Entry& entry : getSorted()) {
+        appendEntry(cost_name, entry.program, entry.total_steps, entry.sequence_number, result);
+    }
+    return result;
+}
+
+// Heap order
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ResultSink<InstructionSet, N, K, T, ProgramClass>::isBetter(const Entry& entry1, const Entry& entry2) noexcept {
+    if (entry1.total_steps != entry2.total_steps) {
+        return entry1.total_steps < entry2.total_steps;
+    }
+    return entry1.sequence_number < entry2.sequence_number;
+}
+
+// Check if programs are streamed to text file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool ResultSink<InstructionSet, N, K, T, ProgramClass>::isStreaming() const noexcept {
+    return stream_writer != nullptr || stream.is_open();
+}
+
+// Format serialized records as text
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::formatRecords(const std::string& cost_name_arg, const std::uint8_t* data, std::size_t size,
+                                                                          std::string& output) {
+    Program<InstructionSet, N, K, T> program;
+    std::string error;
+    std::size_t offset = 0;
+    while (offset + RECORD_HEADER_SIZE < size) {
+        const std::uint64_t total_steps = readLittleEndian(data + offset, 8);
+        const std::uint64_t sequence_number = readLittleEndian(data + offset + 8, 8);
+        std::size_t consumed = 0;
+        // Records are serialized by add() from valid programs, so they always decode
+        if (!ProgramSerializer<InstructionSet, N, K, T>::deserialize(data + offset + RECORD_HEADER_SIZE, size - offset - RECORD_HEADER_SIZE, program, consumed, error)) {
+            assert(false);
+            break;
+        }
+        appendEntry(cost_name_arg, program, total_steps, sequence_number, output);
+        offset += RECORD_HEADER_SIZE + consumed;
+    }
+}
+
+// Append text of program with its cost
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+template<typename AnyProgram>
+inline void ResultSink<InstructionSet, N, K, T, ProgramClass>::appendEntry(const std::string& cost_name_arg, const AnyProgram& program, std::uint64_t total_steps,
+                                                                        std::uint64_t sequence_number, std::string& output) {
+    char buffer[MAX_NUMBER_TEXT_SIZE];
+    output += "\n--- Valid Program #";
+    output.append(buffer, appendNumber(buffer, sequence_number));
+    output += " (";
+    output += cost_name_arg;
+    output += ": ";
+    output.append(buffer, appendNumber(buffer, total_steps));
+    output += ") ---\n";
+    program.appendTo(output);
+    output += '\n';
+}
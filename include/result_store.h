@@ -0,0 +1,137 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "async_writer.h"
+#include "mapped_file.h"
+#include "packed_instruction.h"
+#include "program.h"
+#include "program_serialization.h"
+
+// Append-only binary file of valid programs with their cost
+// Layout, all fields are little-endian:
+// * file header - 16 bytes: magic "ALGOPTRS", version (4 bytes), instruction set, N, K, T (1 byte each)
+// * records     - total steps (8 bytes), serialized program (see SerializedProgramHeader), zero padding to multiple of 8 bytes
+// Incomplete record at the end of file is left by interrupted writer, it is ignored by readers and overwritten by the next writer
+struct ResultStoreFormat {
+    static constexpr char MAGIC[8] = {'A', 'L', 'G', 'O', 'P', 'T', 'R', 'S'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t RECORD_ALIGNMENT = 8;
+    static constexpr std::size_t TOTAL_STEPS_SIZE = 8;
+
+    // Write file header into HEADER_SIZE bytes
+    static void writeHeader(const SerializedProgramHeader& program_header, std::uint8_t* data) noexcept;
+
+    // Read instruction set and N, K, T from file header, length of program_header is 0
+    // Returns false and sets error if data doesn't start with file header of supported version
+    static bool readHeader(const std::uint8_t* data, std::size_t size, SerializedProgramHeader& program_header, std::string& error);
+
+    // Size of record of program of the given length including padding
+    static std::size_t getRecordSize(std::uint32_t length) noexcept;
+
+    // End of the complete records which start at offset, scanning stops at the first incomplete record
+    // Offsets of found records are appended to record_offsets if it isn't null
+    static std::size_t findEnd(const std::uint8_t* data, std::size_t size, std::size_t offset, std::vector<std::size_t>* record_offsets);
+};
+
+// Writer of result store, programs are appended to the existing store of the same type
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+class ResultStoreWriter {
+public:
+    using SerializerType = ProgramSerializer<InstructionSet, N, K, T>;
+
+    // Constructors
+    ResultStoreWriter() = default;
+    ~ResultStoreWriter();
+
+    ResultStoreWriter(const ResultStoreWriter&) = delete;
+    ResultStoreWriter& operator=(const ResultStoreWriter&) = delete;
+
+    // Open store for appending, it is created if it doesn't exist
+    // Records are written by the writer thread of async_writer if it isn't null, async_writer must outlive the store
+    // Returns false and sets error if file can't be opened or holds programs of other type
+    bool open(const std::string& file_name, std::string& error, AsyncWriter* async_writer = nullptr);
+
+    // Flush and close store
+    void close();
+
+    // Check if store is open
+    bool isOpen() const noexcept;
+
+    // Append program with its cost
+    template<typename ProgramClass>
+    void append(const ProgramClass& program, std::uint64_t total_steps);
+
+    // Write buffered records to file, waits for the writer thread
+    void flush();
+
+    // Check if writing records failed, e.g. disk is full, it is exact after flush() or close()
+    bool hasWriteError() const noexcept;
+
+    // Count of records appended since open()
+    std::uint64_t getAppendedCount() const noexcept;
+
+private:
+    std::ofstream stream;
+    AsyncWriter* writer = nullptr;
+    AsyncWriter::ChannelId channel = 0;
+    std::vector<std::uint8_t> buffer;
+    std::uint64_t appended_count = 0;
+    bool write_failed = false;
+};
+
+// Read-only view of result store mapped into memory
+// Records are located once on open(), then each record is accessed in constant time without copying
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+class ResultStoreView {
+public:
+    using SerializerType = ProgramSerializer<InstructionSet, N, K, T>;
+    using PackedInstructionType = PackedInstruction<N, K, T>;
+
+    // Record which points into mapped file
+    struct Record {
+        std::uint64_t total_steps = 0;
+        std::uint32_t length = 0;                      // Count of instructions
+        const std::uint8_t* instructions = nullptr;   // Little-endian packed instructions
+
+        // Packed instruction at position
+        PackedInstructionType getInstruction(std::uint32_t position) const;
+    };
+
+    // Constructors
+    ResultStoreView() = default;
+
+    // Map store, returns false and sets error if file can't be mapped or holds programs of other type
+    bool open(const std::string& file_name, std::string& error);
+
+    // Unmap store
+    void close() noexcept;
+
+    // Check if store is mapped
+    bool isOpen() const noexcept;
+
+    // Count of complete records
+    std::size_t size() const noexcept;
+
+    // Check if file ends with incomplete record
+    bool isTruncated() const noexcept;
+
+    // Access to record
+    Record operator[](std::size_t index) const;
+
+    // Decode program of record, returns false and sets error if record contains instruction outside of instruction set
+    template<typename ProgramClass = Program<InstructionSet, N, K, T>>
+    bool getProgram(std::size_t index, ProgramClass& program, std::string& error) const;
+
+private:
+    MappedFile file;
+    std::vector<std::size_t> record_offsets;
+    bool truncated = false;
+};
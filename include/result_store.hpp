@@ -0,0 +1,268 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include "async_writer.hpp"
+#include "mapped_file.hpp"
+#include "packed_instruction.hpp"
+#include "program.hpp"
+#include "program_serialization.hpp"
+#include "result_store.h"
+
+// Write file header
+inline void ResultStoreFormat::writeHeader(const SerializedProgramHeader& program_header, std::uint8_t* data) noexcept {
+    std::memcpy(data, MAGIC, sizeof(MAGIC));
+    writeLittleEndian(VERSION, 4, data + 8);
+    data[12] = static_cast<std::uint8_t>(program_header.instruction_set);
+    data[13] = program_header.n;
+    data[14] = program_header.k;
+    data[15] = program_header.t;
+}
+
+// Read file header
+inline bool ResultStoreFormat::readHeader(const std::uint8_t* data, std::size_t size, SerializedProgramHeader& program_header, std::string& error) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "Not a result store";
+        return false;
+    }
+    const std::uint32_t version = static_cast<std::uint32_t>(readLittleEndian(data + 8, 4));
+    if (version != VERSION) {
+        error = "Unsupported result store version " + std::to_string(version);
+        return false;
+    }
+    program_header.instruction_set = static_cast<EInstructionSetId>(data[12]);
+    program_header.n = data[13];
+    program_header.k = data[14];
+    program_header.t = data[15];
+    program_header.length = 0;
+    return true;
+}
+
+// Size of record including padding
+inline std::size_t ResultStoreFormat::getRecordSize(std::uint32_t length) noexcept {
+    const std::size_t size = TOTAL_STEPS_SIZE + SerializedProgramHeader::SIZE + static_cast<std::size_t>(length) * SerializedProgramHeader::INSTRUCTION_SIZE;
+    return (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+}
+
+// End of the complete records
+inline std::size_t ResultStoreFormat::findEnd(const std::uint8_t* data, std::size_t size, std::size_t offset, std::vector<std::size_t>* record_offsets) {
+    while (size - offset >= TOTAL_STEPS_SIZE + SerializedProgramHeader::SIZE) {
+        const SerializedProgramHeader program_header = SerializedProgramHeader::read(data + offset + TOTAL_STEPS_SIZE);
+        const std::size_t record_size = getRecordSize(program_header.length);
+        if (size - offset < record_size) {
+            break;
+        }
+        if (record_offsets != nullptr) {
+            record_offsets->push_back(offset);
+        }
+        offset += record_size;
+    }
+    return offset;
+}
+
+// Destructor
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline ResultStoreWriter<InstructionSet, N, K, T>::~ResultStoreWriter() {
+    close();
+}
+
+// Open store for appending
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreWriter<InstructionSet, N, K, T>::open(const std::string& file_name, std::string& error, AsyncWriter* async_writer) {
+    close();
+    appended_count = 0;
+    write_failed = false;
+
+    std::error_code error_code;
+    const bool exists = std::filesystem::exists(file_name, error_code);
+    const std::uintmax_t existing_size = exists ? std::filesystem::file_size(file_name, error_code) : 0;
+    if (error_code) {
+        error = "Can't access " + file_name + ": " + error_code.message();
+        return false;
+    }
+
+    if (existing_size > 0) {
+        // Check type of existing store and drop incomplete record left by interrupted writer
+        std::size_t end = 0;
+        {
+            MappedFile existing;
+            if (!existing.open(file_name, error)) {
+                return false;
+            }
+            SerializedProgramHeader program_header;
+            if (!ResultStoreFormat::readHeader(existing.data(), existing.size(), program_header, error) ||
+                !SerializerType::isCompatible(program_header, error)) {
+                error = file_name + ": " + error;
+                return false;
+            }
+            end = ResultStoreFormat::findEnd(existing.data(), existing.size(), ResultStoreFormat::HEADER_SIZE, nullptr);
+        }
+        if (end != existing_size) {
+            std::filesystem::resize_file(file_name, end, error_code);
+            if (error_code) {
+                error = "Can't truncate " + file_name + ": " + error_code.message();
+                return false;
+            }
+        }
+        stream.open(file_name, std::ios::out | std::ios::binary | std::ios::app);
+    } else {
+        stream.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (stream.is_open()) {
+            std::uint8_t header[ResultStoreFormat::HEADER_SIZE];
+            ResultStoreFormat::writeHeader(SerializerType::makeHeader(0), header);
+            stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        }
+    }
+    if (!stream.is_open()) {
+        error = "Can't open " + file_name + " for writing";
+        return false;
+    }
+    if (async_writer != nullptr) {
+        writer = async_writer;
+        channel = writer->addChannel(std::move(stream));
+    }
+    return true;
+}
+
+// Flush and close store
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void ResultStoreWriter<InstructionSet, N, K, T>::close() {
+    if (writer != nullptr) {
+        writer->closeChannel(channel);
+        write_failed = write_failed || writer->hasFailed(channel);
+        writer = nullptr;
+    }
+    if (stream.is_open()) {
+        stream.close();
+        write_failed = write_failed || !stream;
+    }
+}
+
+// Check if store is open
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreWriter<InstructionSet, N, K, T>::isOpen() const noexcept {
+    return writer != nullptr || stream.is_open();
+}
+
+// Append program with its cost
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline void ResultStoreWriter<InstructionSet, N, K, T>::append(const ProgramClass& program, std::uint64_t total_steps) {
+    assert(isOpen());
+    buffer.resize(ResultStoreFormat::TOTAL_STEPS_SIZE);
+    writeLittleEndian(total_steps, ResultStoreFormat::TOTAL_STEPS_SIZE, buffer.data());
+    SerializerType::serialize(program, buffer);
+    buffer.resize(ResultStoreFormat::getRecordSize(static_cast<std::uint32_t>(program.size())), 0);
+    if (writer != nullptr) {
+        writer->write(channel, buffer.data(), buffer.size());
+    } else {
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+    ++appended_count;
+}
+
+// Write buffered records to file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void ResultStoreWriter<InstructionSet, N, K, T>::flush() {
+    if (writer != nullptr) {
+        writer->flush();
+        write_failed = write_failed || writer->hasFailed(channel);
+    } else if (stream.is_open()) {
+        stream.flush();
+        write_failed = write_failed || !stream;
+    }
+}
+
+// Check if writing records failed
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreWriter<InstructionSet, N, K, T>::hasWriteError() const noexcept {
+    return write_failed;
+}
+
+// Count of records appended since open()
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::uint64_t ResultStoreWriter<InstructionSet, N, K, T>::getAppendedCount() const noexcept {
+    return appended_count;
+}
+
+// Packed instruction at position
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline typename ResultStoreView<InstructionSet, N, K, T>::PackedInstructionType ResultStoreView<InstructionSet, N, K, T>::Record::getInstruction(std::uint32_t position) const {
+    assert(position < length);
+    PackedInstructionType packed;
+    packed.word = static_cast<std::uint32_t>(readLittleEndian(instructions + static_cast<std::size_t>(position) * SerializedProgramHeader::INSTRUCTION_SIZE, 4));
+    return packed;
+}
+
+// Map store
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreView<InstructionSet, N, K, T>::open(const std::string& file_name, std::string& error) {
+    close();
+    if (!file.open(file_name, error)) {
+        return false;
+    }
+    SerializedProgramHeader program_header;
+    if (!ResultStoreFormat::readHeader(file.data(), file.size(), program_header, error) ||
+        !SerializerType::isCompatible(program_header, error)) {
+        error = file_name + ": " + error;
+        file.close();
+        return false;
+    }
+    const std::size_t end = ResultStoreFormat::findEnd(file.data(), file.size(), ResultStoreFormat::HEADER_SIZE, &record_offsets);
+    truncated = end != file.size();
+    return true;
+}
+
+// Unmap store
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void ResultStoreView<InstructionSet, N, K, T>::close() noexcept {
+    file.close();
+    record_offsets.clear();
+    truncated = false;
+}
+
+// Check if store is mapped
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreView<InstructionSet, N, K, T>::isOpen() const noexcept {
+    return file.isOpen();
+}
+
+// Count of complete records
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::size_t ResultStoreView<InstructionSet, N, K, T>::size() const noexcept {
+    return record_offsets.size();
+}
+
+// Check if file ends with incomplete record
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool ResultStoreView<InstructionSet, N, K, T>::isTruncated() const noexcept {
+    return truncated;
+}
+
+// Access to record
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline typename ResultStoreView<InstructionSet, N, K, T>::Record ResultStoreView<InstructionSet, N, K, T>::operator[](std::size_t index) const {
+    assert(index < record_offsets.size());
+    const std::uint8_t* data = file.data() + record_offsets[index];
+    Record record;
+    record.total_steps = readLittleEndian(data, ResultStoreFormat::TOTAL_STEPS_SIZE);
+    record.length = SerializedProgramHeader::read(data + ResultStoreFormat::TOTAL_STEPS_SIZE).length;
+    record.instructions = data + ResultStoreFormat::TOTAL_STEPS_SIZE + SerializedProgramHeader::SIZE;
+    return record;
+}
+
+// Decode program of record
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool ResultStoreView<InstructionSet, N, K, T>::getProgram(std::size_t index, ProgramClass& program, std::string& error) const {
+    assert(index < record_offsets.size());
+    const std::size_t offset = record_offsets[index] + ResultStoreFormat::TOTAL_STEPS_SIZE;
+    std::size_t consumed = 0;
+    return SerializerType::deserialize(file.data() + offset, file.size() - offset, program, consumed, error);
+}
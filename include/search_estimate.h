@@ -0,0 +1,42 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Estimate of search of one program size extrapolated from random sample of candidates
+struct SizeEstimate {
+    unsigned program_size = 0;
+    double space_size = 0.0;             // Count of candidates, approximate beyond 2^53
+    std::uint64_t sampled = 0;           // Count of sampled candidates
+    std::uint64_t sampled_pruned = 0;    // Sampled candidates dropped by static pruning
+    std::uint64_t sampled_valid = 0;     // Sampled candidates which passed verification
+    double sample_seconds = 0.0;         // Wall time of pruning and verification of the sample
+
+    // Expected count of candidates which reach verification
+    double getExpectedVerified() const noexcept;
+
+    // Expected count of valid candidates
+    double getExpectedValid() const noexcept;
+
+    // Projected wall time of the whole size on one core
+    double getProjectedSeconds() const noexcept;
+};
+
+// Estimate of Optimize::speed() extrapolated from random samples of each program size
+// Sampled candidates are verified without cost bound, so projected time is an upper bound for top-K searches
+struct SearchEstimate {
+    std::vector<SizeEstimate> by_program_size; // Index is program size - 1
+
+    // Total count of candidates
+    double getSpaceSize() const noexcept;
+
+    // Projected wall time of the whole search on the given count of cores, linear scaling is assumed
+    double getProjectedSeconds(unsigned core_count = 1) const noexcept;
+
+    // Dump estimate of each size and projected time for the given core counts as text representation
+    std::string dump(const std::vector<unsigned>& core_counts = {1, 4, 16, 64}) const;
+};
@@ -0,0 +1,69 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <sstream>
+#include "search_estimate.h"
+
+// Expected count of candidates which reach verification
+inline double SizeEstimate::getExpectedVerified() const noexcept {
+    if (sampled == 0) {
+        return space_size;
+    }
+    return space_size * static_cast<double>(sampled - sampled_pruned) / static_cast<double>(sampled);
+}
+
+// Expected count of valid candidates
+inline double SizeEstimate::getExpectedValid() const noexcept {
+    if (sampled == 0) {
+        return 0.0;
+    }
+    return space_size * static_cast<double>(sampled_valid) / static_cast<double>(sampled);
+}
+
+// Projected wall time of the whole size on one core
+inline double SizeEstimate::getProjectedSeconds() const noexcept {
+    if (sampled == 0) {
+        return 0.0;
+    }
+    return space_size * sample_seconds / static_cast<double>(sampled);
+}
+
+// Total count of candidates
+inline double SearchEstimate::getSpaceSize() const noexcept {
+    double result = 0.0;
+    for (const SizeEstimate& size_estimate : by_program_size) {
+        result += size_estimate.space_size;
+    }
+    return result;
+}
+
+// Projected wall time of the whole search
+inline double SearchEstimate::getProjectedSeconds(unsigned core_count) const noexcept {
+    double result = 0.0;
+    for (const SizeEstimate& size_estimate : by_program_size) {
+        result += size_estimate.getProjectedSeconds();
+    }
+    return core_count > 0 ? result / static_cast<double>(core_count) : result;
+}
+
+// Dump estimate
+inline std::string SearchEstimate::dump(const std::vector<unsigned>& core_counts) const {
+    std::ostringstream oss;
+    for (const SizeEstimate& size_estimate : by_program_size) {
+        oss << "Size " << size_estimate.program_size << ":\n";
+        oss << "  candidates: " << size_estimate.space_size << '\n';
+        oss << "  sampled: " << size_estimate.sampled << " (pruned " << size_estimate.sampled_pruned
+            << ", valid " << size_estimate.sampled_valid << ")\n";
+        oss << "  expected after pruning: " << size_estimate.getExpectedVerified() << '\n';
+        oss << "  expected valid: " << size_estimate.getExpectedValid() << '\n';
+        oss << "  projected time: " << size_estimate.getProjectedSeconds() << " s\n";
+    }
+    oss << "Total candidates: " << getSpaceSize() << '\n';
+    for (const unsigned core_count : core_counts) {
+        oss << "Projected time on " << core_count << (core_count == 1 ? " core: " : " cores: ")
+            << getProjectedSeconds(core_count) << " s\n";
+    }
+    return oss.str();
+}
@@ -0,0 +1,80 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "perf_counters.h"
+
+// Reasons to drop candidate before it is executed
+enum class EPruneReason : std::uint8_t {
+    None,                    // Candidate is not pruned
+    UnconditionalEndlessLoop // Control flow from the entry never reaches a conditional jump or the end
+};
+
+// Phases of search measured by hardware counters
+enum class ESearchPhase : std::uint8_t {
+    Generate, // Enumeration and static pruning of candidates
+    Verify,   // Execution of candidates on all inputs
+    Collect   // Passing valid candidates to the sink
+};
+
+// Search counters for one program size or for the whole search
+struct SearchCounters {
+    static constexpr std::size_t PRUNE_REASON_COUNT = static_cast<std::size_t>(EPruneReason::UnconditionalEndlessLoop) + 1;
+    static constexpr std::size_t SEARCH_PHASE_COUNT = static_cast<std::size_t>(ESearchPhase::Collect) + 1;
+
+    std::uint64_t candidates_generated = 0;
+    std::array<std::uint64_t, PRUNE_REASON_COUNT> candidates_pruned{}; // Indexed by EPruneReason, None is unused
+    std::uint64_t rejected_output_mismatch = 0;
+    std::uint64_t rejected_termination_mismatch = 0;
+    std::uint64_t rejected_cost_bound = 0; // Candidates which can't get into the sink, some of them are valid
+    std::uint64_t candidates_valid = 0;    // Valid candidates not rejected by the cost bound
+    std::uint64_t inputs_executed = 0;       // Candidate runs, one per candidate and input
+    std::uint64_t instructions_executed = 0; // Candidate instructions executed by rabbit and turtle together
+    std::uint64_t cycle_checks = 0;          // Rabbit and turtle state comparisons
+    std::uint64_t accelerated_runs = 0;      // Candidate runs finished by closed-form evaluation of counting loops
+    double elapsed_seconds = 0.0;
+    std::array<HardwareCounters, SEARCH_PHASE_COUNT> hardware{}; // Indexed by ESearchPhase, empty if not measured
+
+    // Hardware counters of the given phase
+    const HardwareCounters& getHardware(ESearchPhase phase) const noexcept;
+
+    // Count of candidates pruned by the given reason
+    std::uint64_t getPrunedCount(EPruneReason reason) const noexcept;
+
+    // Count of candidates pruned by all reasons
+    std::uint64_t getPrunedCount() const noexcept;
+
+    // Count of candidates rejected by execution for all reasons
+    std::uint64_t getRejectedCount() const noexcept;
+
+    // Counter value per second of elapsed time, 0 if no time elapsed
+    double getRate(std::uint64_t counter) const noexcept;
+
+    // Accumulate counters
+    SearchCounters& operator+=(const SearchCounters& other) noexcept;
+
+    // Dump counters with rates as text representation
+    std::string dump() const;
+};
+
+// Statistics of Optimize::speed(), totals and breakdown by program size
+struct SearchStats {
+    SearchCounters total;
+    std::vector<SearchCounters> by_program_size; // Index is program size - 1
+    std::string hardware_error;                  // Why hardware counters were requested but not measured
+
+    // Dump totals and breakdown by program size as text representation
+    std::string dump() const;
+};
+
+// Name of prune reason
+const char* getPruneReasonName(EPruneReason reason) noexcept;
+
+// Name of search phase
+const char* getSearchPhaseName(ESearchPhase phase) noexcept;
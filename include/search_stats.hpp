@@ -0,0 +1,122 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <sstream>
+#include "perf_counters.hpp"
+#include "search_stats.h"
+
+// Hardware counters of the given phase
+inline const HardwareCounters& SearchCounters::getHardware(ESearchPhase phase) const noexcept {
+    return hardware[static_cast<std::size_t>(phase)];
+}
+
+// Count of candidates pruned by the given reason
+inline std::uint64_t SearchCounters::getPrunedCount(EPruneReason reason) const noexcept {
+    return candidates_pruned[static_cast<std::size_t>(reason)];
+}
+
+// Count of candidates pruned by all reasons
+inline std::uint64_t SearchCounters::getPrunedCount() const noexcept {
+    std::uint64_t result = 0;
+    for (const std::uint64_t count : candidates_pruned) {
+        result += count;
+    }
+    return result;
+}
+
+// Count of candidates rejected by execution for all reasons
+inline std::uint64_t SearchCounters::getRejectedCount() const noexcept {
+    return rejected_output_mismatch + rejected_termination_mismatch + rejected_cost_bound;
+}
+
+// Counter value per second of elapsed time
+inline double SearchCounters::getRate(std::uint64_t counter) const noexcept {
+    return elapsed_seconds > 0.0 ? static_cast<double>(counter) / elapsed_seconds : 0.0;
+}
+
+// Accumulate counters
+inline SearchCounters& SearchCounters::operator+=(const SearchCounters& other) noexcept {
+    candidates_generated += other.candidates_generated;
+    for (std::size_t i = 0; i < PRUNE_REASON_COUNT; ++i) {
+        candidates_pruned[i] += other.candidates_pruned[i];
+    }
+    rejected_output_mismatch += other.rejected_output_mismatch;
+    rejected_termination_mismatch += other.rejected_termination_mismatch;
+    rejected_cost_bound += other.rejected_cost_bound;
+    candidates_valid += other.candidates_valid;
+    inputs_executed += other.inputs_executed;
+    instructions_executed += other.instructions_executed;
+    cycle_checks += other.cycle_checks;
+    accelerated_runs += other.accelerated_runs;
+    elapsed_seconds += other.elapsed_seconds;
+    for (std::size_t i = 0; i < SEARCH_PHASE_COUNT; ++i) {
+        hardware[i] += other.hardware[i];
+    }
+    return *this;
+}
+
+// Dump counters with rates
+inline std::string SearchCounters::dump() const {
+    std::ostringstream oss;
+    const auto line = [&](const char* name, std::uint64_t counter) {
+        oss << "  " << name << ": " << counter << " (" << getRate(counter) << "/s)\n";
+    };
+    oss << "  elapsed: " << elapsed_seconds << " s\n";
+    line("candidates generated", candidates_generated);
+    for (std::size_t i = 1; i < PRUNE_REASON_COUNT; ++i) {
+        oss << "  pruned, " << getPruneReasonName(static_cast<EPruneReason>(i)) << ": " << candidates_pruned[i] << '\n';
+    }
+    oss << "  rejected, output mismatch: " << rejected_output_mismatch << '\n';
+    oss << "  rejected, termination mismatch: " << rejected_termination_mismatch << '\n';
+    oss << "  rejected, cost bound: " << rejected_cost_bound << '\n';
+    line("valid within cost bound", candidates_valid);
+    line("inputs executed", inputs_executed);
+    line("instructions executed", instructions_executed);
+    line("cycle checks", cycle_checks);
+    line("accelerated runs", accelerated_runs);
+    for (std::size_t i = 0; i < SEARCH_PHASE_COUNT; ++i) {
+        if (hardware[i].hasAny()) {
+            oss << "  hardware, " << getSearchPhaseName(static_cast<ESearchPhase>(i)) << ": " << hardware[i].dump() << '\n';
+        }
+    }
+    return oss.str();
+}
+
+// Dump totals and breakdown by program size
+inline std::string SearchStats::dump() const {
+    std::ostringstream oss;
+    if (!hardware_error.empty()) {
+        oss << "Hardware counters unavailable: " << hardware_error << '\n';
+    }
+    oss << "Total:\n" << total.dump();
+    for (std::size_t i = 0; i < by_program_size.size(); ++i) {
+        oss << "Size " << i + 1 << ":\n" << by_program_size[i].dump();
+    }
+    return oss.str();
+}
+
+// Name of prune reason
+inline const char* getPruneReasonName(EPruneReason reason) noexcept {
+    switch (reason) {
+        case EPruneReason::None:
+            return "none";
+        case EPruneReason::UnconditionalEndlessLoop:
+            return "unconditional endless loop";
+    }
+    return "unknown";
+}
+
+// Name of search phase
+inline const char* getSearchPhaseName(ESearchPhase phase) noexcept {
+    switch (phase) {
+        case ESearchPhase::Generate:
+            return "generate";
+        case ESearchPhase::Verify:
+            return "verify";
+        case ESearchPhase::Collect:
+            return "collect";
+    }
+    return "unknown";
+}
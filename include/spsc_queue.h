@@ -0,0 +1,45 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bounded lock-free queue of one producer thread and one consumer thread
+// Items are moved into preallocated slots, so neither side allocates or takes a lock
+template<typename Item>
+class SpscQueue {
+public:
+    // Size of cache line which separates indices of producer and consumer
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    // Constructors
+    // Capacity is rounded up to power of two
+    explicit SpscQueue(std::size_t capacity_arg);
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Max count of items in queue
+    std::size_t capacity() const noexcept;
+
+    // Producer: move item into queue, returns false and leaves item untouched if queue is full
+    bool tryPush(Item& item);
+
+    // Consumer: move item out of queue, returns false if queue is empty
+    bool tryPop(Item& item);
+
+    // Approximate count of items, exact only if both threads are idle
+    std::size_t size() const noexcept;
+
+private:
+    std::vector<Item> slots;
+    std::size_t mask;
+
+    // Indices grow monotonically, slot is index & mask
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> head{0}; // Next item to pop, written by consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> tail{0}; // Next slot to push, written by producer
+};
@@ -0,0 +1,54 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <utility>
+#include "spsc_queue.h"
+
+// Constructors
+template<typename Item>
+inline SpscQueue<Item>::SpscQueue(std::size_t capacity_arg) {
+    std::size_t rounded = 1;
+    while (rounded < capacity_arg) {
+        rounded *= 2;
+    }
+    slots.resize(rounded);
+    mask = rounded - 1;
+}
+
+// Max count of items in queue
+template<typename Item>
+inline std::size_t SpscQueue<Item>::capacity() const noexcept {
+    return slots.size();
+}
+
+// Producer: move item into queue
+template<typename Item>
+inline bool SpscQueue<Item>::tryPush(Item& item) {
+    const std::uint64_t position = tail.load(std::memory_order_relaxed);
+    if (position - head.load(std::memory_order_acquire) == slots.size()) {
+        return false;
+    }
+    slots[position & mask] = std::move(item);
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+// Consumer: move item out of queue
+template<typename Item>
+inline bool SpscQueue<Item>::tryPop(Item& item) {
+    const std::uint64_t position = head.load(std::memory_order_relaxed);
+    if (position == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    item = std::move(slots[position & mask]);
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+// Approximate count of items
+template<typename Item>
+inline std::size_t SpscQueue<Item>::size() const noexcept {
+    return static_cast<std::size_t>(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+}
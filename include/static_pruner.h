@@ -0,0 +1,29 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include "program.h"
+#include "search_stats.h"
+
+// Template class which drops candidates that can't be valid without executing them
+// Only exact rules are applied: pruned candidate would be rejected by execution anyway
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass = Program<InstructionSet, N, K, T>>
+class StaticPruner {
+public:
+    using ProgramType = ProgramClass;
+
+    // Constructors
+    // original_terminates_arg: original program finishes on at least one input
+    explicit StaticPruner(bool original_terminates_arg);
+
+    // Check candidate, returns EPruneReason::None if it has to be executed
+    EPruneReason check(const ProgramType& program) const;
+
+private:
+    bool original_terminates;
+
+    // Control flow from the entry passes only straight-line instructions and Goto, and never reaches the end
+    // Such candidate loops forever on every input
+    static bool isUnconditionalEndlessLoop(const ProgramType& program);
+};
@@ -0,0 +1,45 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include "packed_instruction.hpp"
+#include "static_pruner.h"
+
+// Constructors
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline StaticPruner<InstructionSet, N, K, T, ProgramClass>::StaticPruner(bool original_terminates_arg)
+    : original_terminates(original_terminates_arg) {
+}
+
+// Check candidate
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline EPruneReason StaticPruner<InstructionSet, N, K, T, ProgramClass>::check(const ProgramType& program) const {
+    // Endless candidate matches only original which never finishes
+    if (original_terminates && isUnconditionalEndlessLoop(program)) {
+        return EPruneReason::UnconditionalEndlessLoop;
+    }
+    return EPruneReason::None;
+}
+
+// Check if control flow from the entry never reaches a conditional jump or the end
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T, typename ProgramClass>
+inline bool StaticPruner<InstructionSet, N, K, T, ProgramClass>::isUnconditionalEndlessLoop(const ProgramType& program) {
+    // Path doesn't depend on data, so after size + 1 transitions inside the program some position repeats
+    std::size_t position = 0;
+    for (std::size_t transition = 0; transition <= program.size(); ++transition) {
+        if (position >= program.size()) {
+            return false;
+        }
+        const auto packed = program[position].encode();
+        if (packed.isUnconditionalJump()) {
+            position = packed.getExtra();
+        } else if (packed.isJump()) {
+            return false;
+        } else {
+            ++position;
+        }
+    }
+    return true;
+}
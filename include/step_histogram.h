@@ -0,0 +1,50 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Histogram of per-input step counts or costs of one program
+// Values below 2 * SUB_BUCKET_COUNT are counted exactly, larger values fall into log-linear buckets
+// whose width is at most 1 / SUB_BUCKET_COUNT of the value, values of MAX_VALUE_BITS and more share the extra last bucket
+class StepHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr std::uint64_t SUB_BUCKET_COUNT = std::uint64_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr std::size_t BUCKET_COUNT = 2 * SUB_BUCKET_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT + 1;
+    static constexpr std::size_t OVERFLOW_BUCKET = BUCKET_COUNT - 1;
+
+    // Constructors
+    StepHistogram();
+
+    // Remove all values
+    void clear() noexcept;
+
+    // Count value
+    void add(std::uint64_t value) noexcept;
+
+    // Count of values
+    std::uint64_t getCount() const noexcept;
+
+    // Nearest-rank percentile, percentile is in (0, 100]
+    // Upper bound of bucket is returned, so the result is never below the exact percentile, zero if histogram is empty
+    std::uint64_t getPercentile(double percentile) const noexcept;
+
+    // Position of nearest-rank percentile among count sorted values, 1-based, zero if count is zero
+    static std::uint64_t getRank(double percentile, std::uint64_t count) noexcept;
+
+    // Bucket of value
+    static std::size_t getBucketIndex(std::uint64_t value) noexcept;
+
+    // Largest value of bucket
+    static std::uint64_t getBucketUpperBound(std::size_t bucket_index) noexcept;
+
+private:
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count = 0;
+    std::size_t used_bucket_count = 0; // Buckets above it are empty, so clear() doesn't touch them
+};
@@ -0,0 +1,91 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include "step_histogram.h"
+
+// Constructors
+inline StepHistogram::StepHistogram() : buckets(BUCKET_COUNT) {
+}
+
+// Remove all values
+inline void StepHistogram::clear() noexcept {
+    std::fill(buckets.begin(), buckets.begin() + used_bucket_count, 0);
+    count = 0;
+    used_bucket_count = 0;
+}
+
+// Count value
+inline void StepHistogram::add(std::uint64_t value) noexcept {
+    const std::size_t bucket_index = getBucketIndex(value);
+    ++buckets[bucket_index];
+    ++count;
+    used_bucket_count = std::max(used_bucket_count, bucket_index + 1);
+}
+
+// Count of values
+inline std::uint64_t StepHistogram::getCount() const noexcept {
+    return count;
+}
+
+// Nearest-rank percentile
+inline std::uint64_t StepHistogram::getPercentile(double percentile) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const std::uint64_t rank = getRank(percentile, count);
+    std::uint64_t seen = 0;
+    for (std::size_t bucket_index = 0; bucket_index < used_bucket_count; ++bucket_index) {
+        seen += buckets[bucket_index];
+        if (seen >= rank) {
+            return getBucketUpperBound(bucket_index);
+        }
+    }
+    return getBucketUpperBound(used_bucket_count - 1);
+}
+
+// Position of nearest-rank percentile among sorted values
+inline std::uint64_t StepHistogram::getRank(double percentile, std::uint64_t count) noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const double rank = std::ceil(percentile / 100.0 * static_cast<double>(count));
+    if (rank < 1.0) {
+        return 1;
+    }
+    return rank >= static_cast<double>(count) ? count : static_cast<std::uint64_t>(rank);
+}
+
+// Bucket of value
+inline std::size_t StepHistogram::getBucketIndex(std::uint64_t value) noexcept {
+    if (value < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<std::size_t>(value);
+    }
+    const unsigned top_bit = static_cast<unsigned>(std::bit_width(value)) - 1;
+    if (top_bit >= MAX_VALUE_BITS) {
+        return OVERFLOW_BUCKET;
+    }
+    // Top SUB_BUCKET_BITS + 1 bits of value select the bucket within its power of two
+    const unsigned shift = top_bit - SUB_BUCKET_BITS;
+    const std::uint64_t sub_bucket = (value >> shift) - SUB_BUCKET_COUNT;
+    return static_cast<std::size_t>(2 * SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_COUNT + sub_bucket);
+}
+
+// Largest value of bucket
+inline std::uint64_t StepHistogram::getBucketUpperBound(std::size_t bucket_index) noexcept {
+    if (bucket_index < 2 * SUB_BUCKET_COUNT) {
+        return bucket_index;
+    }
+    if (bucket_index == OVERFLOW_BUCKET) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    const std::uint64_t offset = bucket_index - 2 * SUB_BUCKET_COUNT;
+    const unsigned shift = static_cast<unsigned>(offset / SUB_BUCKET_COUNT) + 1;
+    const std::uint64_t sub_bucket = offset % SUB_BUCKET_COUNT;
+    return ((SUB_BUCKET_COUNT + sub_bucket + 1) << shift) - 1;
+}
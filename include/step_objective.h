@@ -0,0 +1,39 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "step_histogram.h"
+
+// Aggregate of per-input step counts or costs which Optimize::speed() minimises
+enum class EStepObjective : std::uint8_t {
+    Total,     // Sum over all inputs
+    Max,       // Worst input
+    Percentile // Nearest-rank percentile over all inputs, see StepHistogram
+};
+
+// Objective of the search
+struct StepObjective {
+    EStepObjective type = EStepObjective::Total;
+    double percentile = 99.0; // Percentile objective only, in (0, 100]
+
+    // Constructors
+    static StepObjective makeTotal() noexcept;
+    static StepObjective makeMax() noexcept;
+    static StepObjective makePercentile(double percentile_arg) noexcept;
+
+    // Check if objective needs histogram of per-input values
+    bool needsHistogram() const noexcept;
+
+    // Count of inputs whose value may reach cost bound while value of objective is still below it
+    // Total objective bounds the sum, so every input may exceed the bound
+    std::uint64_t getAllowedOverBound(std::uint64_t input_count) const noexcept;
+
+    // Value of objective from aggregates of per-input values, histogram is used by Percentile objective only
+    std::uint64_t getValue(std::uint64_t total, std::uint64_t worst, const StepHistogram* histogram) const noexcept;
+
+    // Text representation: "total", "max" or percentile, e.g. "p99"
+    std::string toString() const;
+};
@@ -0,0 +1,75 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include <sstream>
+#include "step_histogram.hpp"
+#include "step_objective.h"
+
+// Constructors
+inline StepObjective StepObjective::makeTotal() noexcept {
+    return StepObjective{};
+}
+
+inline StepObjective StepObjective::makeMax() noexcept {
+    StepObjective objective;
+    objective.type = EStepObjective::Max;
+    return objective;
+}
+
+inline StepObjective StepObjective::makePercentile(double percentile_arg) noexcept {
+    StepObjective objective;
+    objective.type = EStepObjective::Percentile;
+    objective.percentile = percentile_arg;
+    return objective;
+}
+
+// Check if objective needs histogram of per-input values
+inline bool StepObjective::needsHistogram() const noexcept {
+    return type == EStepObjective::Percentile;
+}
+
+// Count of inputs whose value may reach cost bound
+inline std::uint64_t StepObjective::getAllowedOverBound(std::uint64_t input_count) const noexcept {
+    switch (type) {
+        case EStepObjective::Total:
+            return input_count;
+        case EStepObjective::Max:
+            return 0;
+        case EStepObjective::Percentile:
+            return input_count - StepHistogram::getRank(percentile, input_count);
+    }
+    return input_count;
+}
+
+// Value of objective
+inline std::uint64_t StepObjective::getValue(std::uint64_t total, std::uint64_t worst, const StepHistogram* histogram) const noexcept {
+    switch (type) {
+        case EStepObjective::Total:
+            return total;
+        case EStepObjective::Max:
+            return worst;
+        case EStepObjective::Percentile:
+            assert(histogram);
+            return histogram->getPercentile(percentile);
+    }
+    return total;
+}
+
+// Text representation
+inline std::string StepObjective::toString() const {
+    switch (type) {
+        case EStepObjective::Total:
+            return "total";
+        case EStepObjective::Max:
+            return "max";
+        case EStepObjective::Percentile: {
+            std::ostringstream oss;
+            oss << 'p' << percentile;
+            return oss.str();
+        }
+    }
+    return "";
+}
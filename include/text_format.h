@@ -0,0 +1,28 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Formatting of text into caller's buffer without allocation
+// Each function writes at output and returns pointer past the written characters, no terminating zero is written
+
+// Buffer size which fits text of any address
+constexpr std::size_t MAX_ADDRESS_TEXT_SIZE = 32;
+
+// Buffer size which fits dump of any instruction with its line number
+constexpr std::size_t MAX_INSTRUCTION_TEXT_SIZE = 128;
+
+// Buffer size which fits any number
+constexpr std::size_t MAX_NUMBER_TEXT_SIZE = 20;
+
+// Append zero-terminated text
+char* appendText(char* output, const char* text) noexcept;
+
+// Append value in decimal
+char* appendNumber(char* output, std::uint64_t value) noexcept;
+
+// Append value in lowercase hexadecimal without prefix
+char* appendHexNumber(char* output, std::uint64_t value) noexcept;
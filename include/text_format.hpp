@@ -0,0 +1,44 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include "text_format.h"
+
+// Append zero-terminated text
+inline char* appendText(char* output, const char* text) noexcept {
+    while (*text != '\0') {
+        *output++ = *text++;
+    }
+    return output;
+}
+
+// Append value in decimal
+inline char* appendNumber(char* output, std::uint64_t value) noexcept {
+    // Digits are produced from the lowest one
+    char digits[MAX_NUMBER_TEXT_SIZE];
+    unsigned count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+        *output++ = digits[--count];
+    }
+    return output;
+}
+
+// Append value in hexadecimal
+inline char* appendHexNumber(char* output, std::uint64_t value) noexcept {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    char digits[MAX_NUMBER_TEXT_SIZE];
+    unsigned count = 0;
+    do {
+        digits[count++] = HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    } while (value != 0);
+    while (count > 0) {
+        *output++ = digits[--count];
+    }
+    return output;
+}
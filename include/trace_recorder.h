@@ -0,0 +1,83 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Recorder of timeline spans in Chrome trace-event JSON format, the file can be opened offline in Perfetto or chrome://tracing
+// Spans may be recorded from any thread, each thread gets its own track
+// openStream() and closeStream() must not race with recording
+class TraceRecorder {
+public:
+    // Constructors
+    TraceRecorder() = default;
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Start writing trace to file, returns false if file can't be opened
+    bool openStream(const std::string& file_name);
+
+    // Finish trace file, it is valid JSON only after this call
+    void closeStream();
+
+    // Check if spans are recorded
+    bool isEnabled() const noexcept;
+
+    // Time since openStream() in nanoseconds
+    std::uint64_t getTimestamp() const noexcept;
+
+    // Name track of the calling thread
+    void setThreadName(const std::string& name);
+
+    // Record span of the calling thread, args_json is content of JSON object without braces, e.g. "\"count\":5"
+    void addSpan(const char* category, const char* name, std::uint64_t start_ns, std::uint64_t finish_ns, const std::string& args_json);
+
+private:
+    std::mutex mutex;
+    std::ofstream stream;
+    std::atomic<bool> enabled = false;     // Checked without mutex before each span
+    bool first_event = true;
+    std::chrono::steady_clock::time_point origin;
+    std::unordered_map<std::thread::id, std::uint32_t> thread_ids;
+
+    // Track of the calling thread, new track is named "thread <id>", mutex must be locked
+    std::uint32_t getThreadId();
+
+    // Write name of track, mutex must be locked
+    void writeThreadName(std::uint32_t thread_id, const std::string& name);
+
+    // Write one event object, mutex must be locked
+    void writeEvent(const std::string& event);
+};
+
+// Span recorded from construction to destruction, does nothing if recorder is null or not enabled
+class TraceSpan {
+public:
+    // Constructors
+    // Category and name must be string literals or outlive the span
+    TraceSpan(TraceRecorder* recorder_arg, const char* category_arg, const char* name_arg);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Attach numeric argument shown in span details
+    void setArg(const char* key, std::uint64_t value);
+
+private:
+    TraceRecorder* recorder;
+    const char* category;
+    const char* name;
+    std::string args_json;
+    std::uint64_t start_ns = 0;
+};
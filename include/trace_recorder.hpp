@@ -0,0 +1,129 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include "json_escape.hpp"
+#include "trace_recorder.h"
+
+// Destructor
+inline TraceRecorder::~TraceRecorder() {
+    closeStream();
+}
+
+// Start writing trace to file
+inline bool TraceRecorder::openStream(const std::string& file_name) {
+    closeStream();
+    stream.open(file_name, std::ios::out | std::ios::trunc);
+    if (!stream.is_open()) {
+        return false;
+    }
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    first_event = true;
+    origin = std::chrono::steady_clock::now();
+    thread_ids.clear();
+    enabled = true;
+    return true;
+}
+
+// Finish trace file
+inline void TraceRecorder::closeStream() {
+    if (stream.is_open()) {
+        stream << "\n]}\n";
+        stream.close();
+    }
+    enabled = false;
+}
+
+// Check if spans are recorded
+inline bool TraceRecorder::isEnabled() const noexcept {
+    return enabled;
+}
+
+// Time since openStream() in nanoseconds
+inline std::uint64_t TraceRecorder::getTimestamp() const noexcept {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+}
+
+// Name track of the calling thread
+inline void TraceRecorder::setThreadName(const std::string& name) {
+    if (!enabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto inserted = thread_ids.emplace(std::this_thread::get_id(), static_cast<std::uint32_t>(thread_ids.size()));
+    writeThreadName(inserted.first->second, name);
+}
+
+// Record span of the calling thread
+inline void TraceRecorder::addSpan(const char* category, const char* name, std::uint64_t start_ns, std::uint64_t finish_ns, const std::string& args_json) {
+    if (!enabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream oss;
+    // Trace-event timestamps are microseconds
+    oss << std::fixed << std::setprecision(3);
+    oss << "{\"name\":\"" << escapeJson(name) << "\",\"cat\":\"" << category << "\",\"ph\":\"X\""
+        << ",\"ts\":" << static_cast<double>(start_ns) / 1000.0
+        << ",\"dur\":" << static_cast<double>(finish_ns - start_ns) / 1000.0
+        << ",\"pid\":1,\"tid\":" << getThreadId();
+    if (!args_json.empty()) {
+        oss << ",\"args\":{" << args_json << '}';
+    }
+    oss << '}';
+    writeEvent(oss.str());
+}
+
+// Track of the calling thread
+inline std::uint32_t TraceRecorder::getThreadId() {
+    const auto inserted = thread_ids.emplace(std::this_thread::get_id(), static_cast<std::uint32_t>(thread_ids.size()));
+    if (inserted.second) {
+        writeThreadName(inserted.first->second, "thread " + std::to_string(inserted.first->second));
+    }
+    return inserted.first->second;
+}
+
+// Write name of track
+inline void TraceRecorder::writeThreadName(std::uint32_t thread_id, const std::string& name) {
+    std::ostringstream oss;
+    oss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_id
+        << ",\"args\":{\"name\":\"" << escapeJson(name) << "\"}}";
+    writeEvent(oss.str());
+}
+
+// Write one event object
+inline void TraceRecorder::writeEvent(const std::string& event) {
+    stream << (first_event ? "\n" : ",\n") << event;
+    first_event = false;
+}
+
+// Constructors
+inline TraceSpan::TraceSpan(TraceRecorder* recorder_arg, const char* category_arg, const char* name_arg)
+    : recorder(recorder_arg != nullptr && recorder_arg->isEnabled() ? recorder_arg : nullptr), category(category_arg), name(name_arg) {
+    if (recorder != nullptr) {
+        start_ns = recorder->getTimestamp();
+    }
+}
+
+inline TraceSpan::~TraceSpan() {
+    if (recorder != nullptr) {
+        recorder->addSpan(category, name, start_ns, recorder->getTimestamp(), args_json);
+    }
+}
+
+// Attach numeric argument
+inline void TraceSpan::setArg(const char* key, std::uint64_t value) {
+    if (recorder == nullptr) {
+        return;
+    }
+    if (!args_json.empty()) {
+        args_json += ',';
+    }
+    args_json += '"';
+    args_json += key;
+    args_json += "\":";
+    args_json += std::to_string(value);
+}
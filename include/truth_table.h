@@ -0,0 +1,96 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "program_serialization.h"
+#include "variables.h"
+
+// Template class for truth table of reference program: output, termination and step count for each input combination
+// Table is built in memory, then it can be saved and mapped back read-only, so searches over the same
+// reference program skip building and concurrent searches share one copy in the page cache
+// File layout, all fields are little-endian:
+// * header  - 40 bytes: magic "ALGOPTTT", version (4 bytes), instruction set, N, K, T (1 byte each),
+//             program hash (8 bytes), step limit (8 bytes), entry count (8 bytes)
+// * program - serialized reference program (see SerializedProgramHeader), zero padding to multiple of 8 bytes
+// * steps   - step count of each entry, 4 bytes each
+// * outputs - K output values of each entry
+// * flags   - 1 byte of each entry, bit 0 is set if program was stopped as infinite loop
+// Entry index is the input combination read as little-endian number: input[0] is the lowest byte
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+class TruthTable {
+public:
+    using InputVariablesType = InputVariables<N>;
+    using OutputVariablesType = OutputVariables<K>;
+    using SerializerType = ProgramSerializer<InstructionSet, N, K, T>;
+
+    static constexpr char MAGIC[8] = {'A', 'L', 'G', 'O', 'P', 'T', 'T', 'T'};
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 40;
+    static constexpr std::uint64_t ENTRY_COUNT = std::uint64_t(1) << (8 * N);
+    static constexpr std::uint8_t INFINITE_LOOP_FLAG = 1;
+
+    static_assert(N < 8, "Entry index of truth table must fit into 64 bits");
+
+    // Constructors
+    TruthTable() = default;
+
+    TruthTable(const TruthTable&) = delete;
+    TruthTable& operator=(const TruthTable&) = delete;
+
+    // Allocate in-memory table of program, entries are filled by set()
+    // step_limit is the step count after which executor reports infinite loop, a mapped table must match it
+    template<typename ProgramClass>
+    void create(const ProgramClass& program, std::uint64_t step_limit);
+
+    // Set entry of in-memory table, step count must fit into 32 bits
+    void set(std::uint64_t index, const OutputVariablesType& output, std::uint64_t step_count, bool infinite_loop);
+
+    // Save in-memory table, file is written under temporary name and renamed, so readers never see partial table
+    bool save(const std::string& file_name, std::string& error) const;
+
+    // Map table saved for program with the same step limit, returns false and sets error if file is missing or doesn't match
+    // Mapped table replaces in-memory one, in-memory table is kept open if file isn't mapped
+    template<typename ProgramClass>
+    bool load(const std::string& file_name, const ProgramClass& program, std::uint64_t step_limit, std::string& error);
+
+    // Drop table
+    void close() noexcept;
+
+    // Check if table is created or loaded
+    bool isOpen() const noexcept;
+
+    // Check if table is mapped from file
+    bool isMapped() const noexcept;
+
+    // Name of table file of program in directory, it contains instruction set, N, K, T and program hash
+    template<typename ProgramClass>
+    static std::string getFileName(const std::string& directory, const ProgramClass& program);
+
+    // Entry index of input combination
+    static std::uint64_t getIndex(const InputVariablesType& input) noexcept;
+
+    // Access to entry
+    OutputVariablesType getOutput(std::uint64_t index) const noexcept;
+    std::uint64_t getStepCount(std::uint64_t index) const noexcept;
+    bool isInfiniteLoop(std::uint64_t index) const noexcept;
+
+private:
+    std::vector<std::uint8_t> buffer;
+    MappedFile file;
+    const std::uint8_t* data = nullptr;
+    std::size_t steps_offset = 0;
+    std::size_t outputs_offset = 0;
+    std::size_t flags_offset = 0;
+
+    // Offsets of arrays after header and program of the given serialized size
+    void setOffsets(std::size_t serialized_size) noexcept;
+
+    // Size of table image with program of the given serialized size
+    static std::size_t getImageSize(std::size_t serialized_size) noexcept;
+};
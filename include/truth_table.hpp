@@ -0,0 +1,204 @@
+// Copyright 2025 Petr Petrov. All rights reserved.
+// License: https://github.com/PetrPPetrov/algopt/blob/main/LICENSE
+
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <thread>
+#include "mapped_file.hpp"
+#include "program_serialization.hpp"
+#include "truth_table.h"
+
+// Allocate in-memory table of program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline void TruthTable<InstructionSet, N, K, T>::create(const ProgramClass& program, std::uint64_t step_limit) {
+    close();
+    std::vector<std::uint8_t> serialized_program;
+    SerializerType::serialize(program, serialized_program);
+
+    buffer.assign(getImageSize(serialized_program.size()), 0);
+    std::uint8_t* image = buffer.data();
+    std::memcpy(image, MAGIC, sizeof(MAGIC));
+    writeLittleEndian(VERSION, 4, image + 8);
+    std::memcpy(image + 12, serialized_program.data(), 4); // Instruction set, N, K, T
+    writeLittleEndian(SerializerType::getHash(program), 8, image + 16);
+    writeLittleEndian(step_limit, 8, image + 24);
+    writeLittleEndian(ENTRY_COUNT, 8, image + 32);
+    std::memcpy(image + HEADER_SIZE, serialized_program.data(), serialized_program.size());
+
+    data = buffer.data();
+    setOffsets(serialized_program.size());
+}
+
+// Set entry of in-memory table
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void TruthTable<InstructionSet, N, K, T>::set(std::uint64_t index, const OutputVariablesType& output, std::uint64_t step_count, bool infinite_loop) {
+    assert(!buffer.empty() && index < ENTRY_COUNT);
+    assert(step_count <= UINT32_MAX);
+    std::uint8_t* image = buffer.data();
+    writeLittleEndian(step_count, 4, image + steps_offset + index * 4);
+    std::memcpy(image + outputs_offset + index * K, output.values.data(), K);
+    image[flags_offset + index] = infinite_loop ? INFINITE_LOOP_FLAG : 0;
+}
+
+// Save in-memory table
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool TruthTable<InstructionSet, N, K, T>::save(const std::string& file_name, std::string& error) const {
+    assert(!buffer.empty());
+
+    // Temporary name is unique per thread, so concurrent searches may save the same table
+    std::ostringstream temp_name;
+    temp_name << file_name << ".tmp" << std::hex << std::hash<std::thread::id>()(std::this_thread::get_id())
+              << '_' << std::chrono::steady_clock::now().time_since_epoch().count();
+    {
+        std::ofstream stream(temp_name.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!stream.is_open()) {
+            error = "Can't write " + temp_name.str();
+            return false;
+        }
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        if (!stream) {
+            error = "Can't write " + temp_name.str();
+            stream.close();
+            std::error_code ignored;
+            std::filesystem::remove(temp_name.str(), ignored);
+            return false;
+        }
+    }
+
+    std::error_code error_code;
+    std::filesystem::rename(temp_name.str(), file_name, error_code);
+    if (error_code) {
+        // Table may be already saved by concurrent search and mapped, then it can't be replaced on some systems
+        std::error_code ignored;
+        std::filesystem::remove(temp_name.str(), ignored);
+        if (!std::filesystem::exists(file_name, ignored)) {
+            error = "Can't rename " + temp_name.str() + " to " + file_name + ": " + error_code.message();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Map table saved for program
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline bool TruthTable<InstructionSet, N, K, T>::load(const std::string& file_name, const ProgramClass& program, std::uint64_t step_limit, std::string& error) {
+    // In-memory table stays open until the file is accepted
+    if (isMapped()) {
+        data = nullptr;
+    }
+    file.close();
+    if (!file.open(file_name, error)) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> serialized_program;
+    SerializerType::serialize(program, serialized_program);
+    const std::uint8_t* image = file.data();
+    const std::size_t image_size = getImageSize(serialized_program.size());
+    if (file.size() < HEADER_SIZE || std::memcmp(image, MAGIC, sizeof(MAGIC)) != 0) {
+        error = file_name + ": not a truth table";
+    } else if (readLittleEndian(image + 8, 4) != VERSION) {
+        error = file_name + ": unsupported truth table version " + std::to_string(readLittleEndian(image + 8, 4));
+    } else if (std::memcmp(image + 12, serialized_program.data(), 4) != 0 || readLittleEndian(image + 32, 8) != ENTRY_COUNT) {
+        error = file_name + ": instruction set or variable count mismatch";
+    } else if (readLittleEndian(image + 24, 8) != step_limit) {
+        error = file_name + ": step limit mismatch";
+    } else if (file.size() != image_size) {
+        error = file_name + ": truth table size mismatch";
+    } else if (readLittleEndian(image + 16, 8) != SerializerType::getHash(program) ||
+               std::memcmp(image + HEADER_SIZE, serialized_program.data(), serialized_program.size()) != 0) {
+        error = file_name + ": truth table of other program";
+    } else {
+        buffer.clear();
+        buffer.shrink_to_fit();
+        data = image;
+        setOffsets(serialized_program.size());
+        return true;
+    }
+    file.close();
+    return false;
+}
+
+// Drop table
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void TruthTable<InstructionSet, N, K, T>::close() noexcept {
+    file.close();
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data = nullptr;
+}
+
+// Check if table is created or loaded
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool TruthTable<InstructionSet, N, K, T>::isOpen() const noexcept {
+    return data != nullptr;
+}
+
+// Check if table is mapped from file
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool TruthTable<InstructionSet, N, K, T>::isMapped() const noexcept {
+    return data != nullptr && data == file.data();
+}
+
+// Name of table file of program in directory
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+template<typename ProgramClass>
+inline std::string TruthTable<InstructionSet, N, K, T>::getFileName(const std::string& directory, const ProgramClass& program) {
+    std::ostringstream name;
+    name << "truth_" << static_cast<unsigned>(InstructionSet<N, K, T>::ID) << '_' << N << '_' << K << '_' << T << '_'
+         << std::hex << std::setw(16) << std::setfill('0') << SerializerType::getHash(program) << ".bin";
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+// Entry index of input combination
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::uint64_t TruthTable<InstructionSet, N, K, T>::getIndex(const InputVariablesType& input) noexcept {
+    std::uint64_t index = 0;
+    for (unsigned i = 0; i < N; ++i) {
+        index |= static_cast<std::uint64_t>(input.values[i]) << (8 * i);
+    }
+    return index;
+}
+
+// Access to entry
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline typename TruthTable<InstructionSet, N, K, T>::OutputVariablesType TruthTable<InstructionSet, N, K, T>::getOutput(std::uint64_t index) const noexcept {
+    OutputVariablesType output;
+    std::memcpy(output.values.data(), data + outputs_offset + index * K, K);
+    return output;
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::uint64_t TruthTable<InstructionSet, N, K, T>::getStepCount(std::uint64_t index) const noexcept {
+    return readLittleEndian(data + steps_offset + index * 4, 4);
+}
+
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline bool TruthTable<InstructionSet, N, K, T>::isInfiniteLoop(std::uint64_t index) const noexcept {
+    return (data[flags_offset + index] & INFINITE_LOOP_FLAG) != 0;
+}
+
+// Offsets of arrays
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline void TruthTable<InstructionSet, N, K, T>::setOffsets(std::size_t serialized_size) noexcept {
+    steps_offset = HEADER_SIZE + (serialized_size + 7) / 8 * 8;
+    outputs_offset = steps_offset + static_cast<std::size_t>(ENTRY_COUNT) * 4;
+    flags_offset = outputs_offset + static_cast<std::size_t>(ENTRY_COUNT) * K;
+}
+
+// Size of table image
+template<template<unsigned, unsigned, unsigned> class InstructionSet, unsigned N, unsigned K, unsigned T>
+inline std::size_t TruthTable<InstructionSet, N, K, T>::getImageSize(std::size_t serialized_size) noexcept {
+    return HEADER_SIZE + (serialized_size + 7) / 8 * 8 + static_cast<std::size_t>(ENTRY_COUNT) * (4 + K + 1);
+}
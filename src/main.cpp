@@ -17,6 +17,8 @@
 #include "rabbit_turtle.hpp"
 #include "debug_executor.h"
 #include "debug_executor.hpp"
+#include "profiling_executor.h"
+#include "profiling_executor.hpp"
 #include "executor.hpp"
 #include "full_state.hpp"
 #include "program.hpp"
@@ -242,11 +244,21 @@ void demonstrateOptimization() {
     std::uint64_t reference_total_steps = optimizer.calculateAverageSteps(reference_program);
     std::cout << "Reference program total steps: " << reference_total_steps << std::endl;
     
+    // Profile reference program over all inputs to see its hot instructions
+    ProfilingExecutor<B1::InstructionSet, N, K, T> profiler(reference_program);
+    profiler.runAllInputs();
+    std::cout << "\n=== Reference Program Profile ===" << std::endl;
+    std::cout << profiler.dump() << std::endl;
+    
     // Display last program ID for program length = 1 (optimization search space)
     constexpr unsigned max_program_size = 1;
     Fabric<B1::InstructionSet, N, K, T> fabric_opt(max_program_size);
     std::cout << "Last program ID for length " << max_program_size << ": " << fabric_opt.getLastProgramStrId() << std::endl;
     
+    // Estimate the search before running it
+    std::cout << "\n=== Search Estimate ===" << std::endl;
+    std::cout << optimizer.estimate(max_program_size, 1.0).dump() << std::endl;
+    
     // Now try to optimize
     std::cout << "\nAttempting optimization (max program size: 1 instruction)..." << std::endl;
     std::cout << "This may take a while..." << std::endl;